@@ -0,0 +1,443 @@
+//
+// Created by lenovo on 10/18/2026.
+//
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include "constants.h"
+#include "bitboard.h"
+#include "attacks.h"
+#include "magic.h"
+#include "utils.h"
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define CHESS_HAVE_PEXT
+#include <cpuid.h>
+#include <immintrin.h>
+#endif
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+#ifndef CHESS_EMBED_TABLES
+// Fallback storage, only touched when the table file can't be mapped.
+static Magic rook_storage[64];
+static Magic bishop_storage[64];
+static uint64_t attack_storage[SLIDER_ATTACK_COUNT];
+static uint8_t index_storage[SLIDER_INDEX_LIMIT];
+static uint8_t pext_storage[PEXT_INDEX_SIZE];
+
+const Magic* ROOK_MAGICS = rook_storage;
+const Magic* BISHOP_MAGICS = bishop_storage;
+const uint64_t* SLIDER_ATTACKS = attack_storage;
+const uint8_t* SLIDER_INDEX = index_storage;
+const uint8_t* PEXT_INDEX = pext_storage;
+
+uint64_t KNIGHT_ATTACKS[64];
+uint64_t KING_ATTACKS[64];
+uint64_t PAWN_ATTACKS[2][64];
+uint64_t BETWEEN[64][64];
+uint64_t LINE[64][64];
+#endif
+
+static const int ROOK_DIRECTIONS[4][2]   = {{1, 0}, {-1, 0}, {0, 1}, {0, -1}};
+static const int BISHOP_DIRECTIONS[4][2] = {{1, 1}, {1, -1}, {-1, 1}, {-1, -1}};
+
+// Reference ray walk: attacked squares from `sq`, stopping at (and including) the first blocker.
+static uint64_t sliding_attacks(int sq, uint64_t blockers, const int directions[4][2]) {
+    uint64_t attacks = 0ULL;
+    for (int d = 0; d < 4; d++) {
+        int r = (sq >> 3) + directions[d][0];
+        int f = (sq & 7) + directions[d][1];
+        while (r >= 0 && r < 8 && f >= 0 && f < 8) {
+            const uint64_t bit = 1ULL << (r * 8 + f);
+            attacks |= bit;
+            if (blockers & bit) break;
+            r += directions[d][0];
+            f += directions[d][1];
+        }
+    }
+    return attacks;
+}
+
+// Ray squares whose occupancy matters: the attacks on an empty board minus the last square of each ray.
+static uint64_t relevant_mask(int sq, const int directions[4][2]) {
+    uint64_t mask = 0ULL;
+    for (int d = 0; d < 4; d++) {
+        int r = (sq >> 3) + directions[d][0];
+        int f = (sq & 7) + directions[d][1];
+        while (r + directions[d][0] >= 0 && r + directions[d][0] < 8 &&
+               f + directions[d][1] >= 0 && f + directions[d][1] < 8) {
+            mask |= 1ULL << (r * 8 + f);
+            r += directions[d][0];
+            f += directions[d][1];
+        }
+    }
+    return mask;
+}
+
+static void init_magic(Magic* m, int sq, uint64_t number, uint8_t bits, const int directions[4][2]) {
+    m->mask = relevant_mask(sq, directions);
+    m->magic = number;
+    m->shift = 64 - bits;
+}
+
+static uint32_t init_dense_magics(Magic* table, uint64_t* attacks, const uint64_t* numbers, const uint8_t* bits,
+                                  const int directions[4][2], uint32_t offset) {
+    for (int sq = 0; sq < 64; sq++) {
+        Magic* m = &table[sq];
+        init_magic(m, sq, numbers[sq], bits[sq], directions);
+        m->offset = offset;
+        m->attacks = 0;
+        m->pext_offset = 0;
+
+        // Enumerate every subset of the mask (Carry-Rippler) and store its attack set.
+        uint64_t blockers = 0ULL;
+        do {
+            const uint64_t index = (blockers * m->magic) >> m->shift;
+            attacks[offset + index] = sliding_attacks(sq, blockers, directions);
+            blockers = (blockers - m->mask) & m->mask;
+        } while (blockers);
+
+        offset += 1U << bits[sq];
+    }
+    return offset;
+}
+
+#define SLOT_FREE 0xFF
+
+typedef struct {
+    uint8_t* index;         // packed windows, SLOT_FREE where no square has claimed a slot
+    uint32_t index_count;   // high-water mark of the packed windows
+    uint8_t* pext_index;
+    uint32_t pext_count;
+    uint64_t* attacks;
+    uint32_t attack_count;
+} SliderPacker;
+
+// Portable PEXT, only used to lay out PEXT_INDEX: gathers the bits of `value` selected
+// by `mask` into the low bits, in mask order.
+static uint64_t soft_pext(uint64_t value, uint64_t mask) {
+    uint64_t result = 0ULL;
+    for (uint64_t bit = 1ULL; mask; bit <<= 1) {
+        const uint64_t low = mask & -mask;
+        if (value & low) result |= bit;
+        mask ^= low;
+    }
+    return result;
+}
+
+typedef struct {
+    Magic* magic;
+    int sq;
+    const int (*directions)[2];
+} PackJob;
+
+// Numbers the square's distinct attack sets into `local` (one byte per magic index) and
+// places that window at the lowest offset where every used slot is free or already
+// holds the same number. The PEXT window gets the same numbers, back to back.
+static void pack_square(SliderPacker* packer, Magic* m, int sq, const int directions[4][2]) {
+    static uint8_t local[4096];
+    const uint32_t size = 1U << (64 - m->shift);
+    memset(local, SLOT_FREE, size);
+
+    uint64_t* distinct = &packer->attacks[packer->attack_count];
+    uint32_t distinct_count = 0;
+    uint64_t blockers = 0ULL;
+    do {
+        const uint64_t attacks = sliding_attacks(sq, blockers, directions);
+        uint32_t n = 0;
+        while (n < distinct_count && distinct[n] != attacks) n++;
+        if (n == distinct_count) distinct[distinct_count++] = attacks;
+        local[(blockers * m->magic) >> m->shift] = (uint8_t)n;
+        packer->pext_index[packer->pext_count + soft_pext(blockers, m->mask)] = (uint8_t)n;
+        blockers = (blockers - m->mask) & m->mask;
+    } while (blockers);
+
+    uint32_t offset = 0;
+    for (;; offset++) {
+        uint32_t i = 0;
+        for (; i < size; i++) {
+            const uint8_t slot = packer->index[offset + i];
+            if (local[i] != SLOT_FREE && slot != SLOT_FREE && slot != local[i]) break;
+        }
+        if (i == size) break;
+    }
+    for (uint32_t i = 0; i < size; i++) {
+        if (local[i] != SLOT_FREE) packer->index[offset + i] = local[i];
+    }
+
+    m->offset = offset;
+    m->attacks = packer->attack_count;
+    m->pext_offset = packer->pext_count;
+    packer->attack_count += distinct_count;
+    packer->pext_count += 1U << popcount(m->mask);
+    if (offset + size > packer->index_count) packer->index_count = offset + size;
+}
+
+#ifndef CHESS_EMBED_TABLES
+static void init_steps(void) {
+    for (int sq = 0; sq < 64; sq++) {
+        const uint64_t bit = 1ULL << sq;
+        KNIGHT_ATTACKS[sq] = generate_knight_attack_mask(bit);
+        KING_ATTACKS[sq] = generate_king_attack_mask(bit);
+        PAWN_ATTACKS[WHITE][sq] = generate_pawn_attack_mask(bit, true);
+        PAWN_ATTACKS[BLACK][sq] = generate_pawn_attack_mask(bit, false);
+    }
+}
+
+static void init_lines(void) {
+    for (int a = 0; a < 64; a++) {
+        const uint64_t a_bit = 1ULL << a;
+        for (int b = 0; b < 64; b++) {
+            const uint64_t b_bit = 1ULL << b;
+            BETWEEN[a][b] = LINE[a][b] = 0ULL;
+            if (a == b) continue;
+
+            if (rook_attacks(a, 0) & b_bit) {
+                LINE[a][b] = (rook_attacks(a, 0) & rook_attacks(b, 0)) | a_bit | b_bit;
+                BETWEEN[a][b] = rook_attacks(a, b_bit) & rook_attacks(b, a_bit);
+            } else if (bishop_attacks(a, 0) & b_bit) {
+                LINE[a][b] = (bishop_attacks(a, 0) & bishop_attacks(b, 0)) | a_bit | b_bit;
+                BETWEEN[a][b] = bishop_attacks(a, b_bit) & bishop_attacks(b, a_bit);
+            }
+        }
+    }
+}
+#endif
+
+uint32_t build_slider_tables(Magic* rook, Magic* bishop, uint8_t* index, uint8_t* pext_index, uint64_t* attacks) {
+    for (int sq = 0; sq < 64; sq++) {
+        init_magic(&rook[sq], sq, MAGIC_ROOK_NUMS[sq], MAGIC_ROOK_SHIFTS[sq], ROOK_DIRECTIONS);
+        init_magic(&bishop[sq], sq, MAGIC_BISHOP_NUMS[sq], MAGIC_BISHOP_SHIFTS[sq], BISHOP_DIRECTIONS);
+    }
+
+    // Largest windows first: the small bishop windows then fill the gaps between them.
+    PackJob jobs[128];
+    for (int sq = 0; sq < 64; sq++) {
+        jobs[sq] = (PackJob){&rook[sq], sq, ROOK_DIRECTIONS};
+        jobs[64 + sq] = (PackJob){&bishop[sq], sq, BISHOP_DIRECTIONS};
+    }
+    for (int i = 1; i < 128; i++) {
+        for (int j = i; j > 0 && jobs[j].magic->shift < jobs[j - 1].magic->shift; j--) {
+            const PackJob job = jobs[j];
+            jobs[j] = jobs[j - 1];
+            jobs[j - 1] = job;
+        }
+    }
+
+    SliderPacker packer = {index, 0, pext_index, 0, attacks, 0};
+    memset(index, SLOT_FREE, SLIDER_INDEX_LIMIT);
+    for (int i = 0; i < 128; i++) pack_square(&packer, jobs[i].magic, jobs[i].sq, jobs[i].directions);
+
+    if (packer.attack_count != SLIDER_ATTACK_COUNT) {
+        fprintf(stderr, "Unexpected slider attack count: %u\n", packer.attack_count);
+        exit(EXIT_FAILURE);
+    }
+    // Unclaimed slots are never read; zero them so the output is deterministic and tidy.
+    for (uint32_t i = 0; i < packer.index_count; i++) {
+        if (index[i] == SLOT_FREE) index[i] = 0;
+    }
+    return packer.index_count;
+}
+
+uint32_t build_dense_slider_tables(Magic* rook, Magic* bishop, uint64_t* attacks) {
+    uint32_t offset = init_dense_magics(rook, attacks, MAGIC_ROOK_NUMS, MAGIC_ROOK_SHIFTS, ROOK_DIRECTIONS, 0);
+    offset = init_dense_magics(bishop, attacks, MAGIC_BISHOP_NUMS, MAGIC_BISHOP_SHIFTS, BISHOP_DIRECTIONS, offset);
+    if (offset > SLIDER_TABLE_SIZE) {
+        fprintf(stderr, "Unexpected slider table size: %u\n", offset);
+        exit(EXIT_FAILURE);
+    }
+    return offset;
+}
+
+// FNV-1a over the magic headers and attack sets (64-bit words) and the index (bytes).
+uint64_t attack_table_checksum(const AttackTableHeader* header, const uint64_t* attacks, const uint8_t* index,
+                               const uint8_t* pext_index) {
+    uint64_t hash = 0xCBF29CE484222325ULL;
+    const uint64_t* words = (const uint64_t*)header->rook;
+    const size_t magic_words = sizeof(header->rook) / 8 + sizeof(header->bishop) / 8;
+    for (size_t i = 0; i < magic_words; i++) hash = (hash ^ words[i]) * 0x100000001B3ULL;
+    for (size_t i = 0; i < header->attack_count; i++) hash = (hash ^ attacks[i]) * 0x100000001B3ULL;
+    for (size_t i = 0; i < header->index_count; i++) hash = (hash ^ index[i]) * 0x100000001B3ULL;
+    for (size_t i = 0; i < PEXT_INDEX_SIZE; i++) hash = (hash ^ pext_index[i]) * 0x100000001B3ULL;
+    return hash;
+}
+
+// === Slider backends ===
+
+static uint64_t magic_rook_attacks(int sq, uint64_t occupancy) {
+    const Magic* m = &ROOK_MAGICS[sq];
+    return SLIDER_ATTACKS[m->attacks + SLIDER_INDEX[m->offset + (((occupancy & m->mask) * m->magic) >> m->shift)]];
+}
+
+static uint64_t magic_bishop_attacks(int sq, uint64_t occupancy) {
+    const Magic* m = &BISHOP_MAGICS[sq];
+    return SLIDER_ATTACKS[m->attacks + SLIDER_INDEX[m->offset + (((occupancy & m->mask) * m->magic) >> m->shift)]];
+}
+
+#ifdef CHESS_HAVE_PEXT
+__attribute__((target("bmi2")))
+static uint64_t pext_rook_attacks(int sq, uint64_t occupancy) {
+    const Magic* m = &ROOK_MAGICS[sq];
+    return SLIDER_ATTACKS[m->attacks + PEXT_INDEX[m->pext_offset + _pext_u64(occupancy, m->mask)]];
+}
+
+__attribute__((target("bmi2")))
+static uint64_t pext_bishop_attacks(int sq, uint64_t occupancy) {
+    const Magic* m = &BISHOP_MAGICS[sq];
+    return SLIDER_ATTACKS[m->attacks + PEXT_INDEX[m->pext_offset + _pext_u64(occupancy, m->mask)]];
+}
+#endif
+
+SliderAttacks rook_attacks = magic_rook_attacks;
+SliderAttacks bishop_attacks = magic_bishop_attacks;
+static SliderBackend current_backend = SLIDERS_MAGIC;
+
+bool pext_is_fast(void) {
+#ifdef CHESS_HAVE_PEXT
+    __builtin_cpu_init();
+    if (!__builtin_cpu_supports("bmi2")) return false;
+    if (__builtin_cpu_is("amd")) {
+        // Zen 1/2 (family 17h) and earlier run PEXT in microcode, far slower than a multiply.
+        unsigned eax, ebx, ecx, edx;
+        if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx)) return false;
+        const unsigned family = ((eax >> 8) & 0xF) + ((eax >> 20) & 0xFF);
+        return family >= 0x19;
+    }
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool select_slider_backend(const SliderBackend backend) {
+    if (backend == SLIDERS_MAGIC) {
+        rook_attacks = magic_rook_attacks;
+        bishop_attacks = magic_bishop_attacks;
+        current_backend = backend;
+        return true;
+    }
+#ifdef CHESS_HAVE_PEXT
+    __builtin_cpu_init();
+    if (backend == SLIDERS_PEXT && __builtin_cpu_supports("bmi2")) {
+        rook_attacks = pext_rook_attacks;
+        bishop_attacks = pext_bishop_attacks;
+        current_backend = backend;
+        return true;
+    }
+#endif
+    return false;
+}
+
+SliderBackend slider_backend(void) {
+    return current_backend;
+}
+
+const char* slider_backend_name(const SliderBackend backend) {
+    return backend == SLIDERS_PEXT ? "pext" : "magic";
+}
+
+static void init_slider_backend(void) {
+    const char* choice = getenv("CHESS_SLIDERS");
+    if (choice) {
+        const SliderBackend backend = strcmp(choice, "pext") == 0 ? SLIDERS_PEXT : SLIDERS_MAGIC;
+        if (select_slider_backend(backend)) return;
+        fprintf(stderr, "Slider backend %s is not supported here, using magics\n", choice);
+    }
+    select_slider_backend(pext_is_fast() ? SLIDERS_PEXT : SLIDERS_MAGIC);
+}
+
+#ifndef CHESS_EMBED_TABLES
+bool load_attack_tables(const char* path) {
+#ifdef _WIN32
+    (void)path;
+    return false;
+#else
+    const int fd = open(path, O_RDONLY);
+    if (fd < 0) return false;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(AttackTableHeader)) {
+        close(fd);
+        return false;
+    }
+
+    // MAP_SHARED + PROT_READ: every engine process on the host maps the same page-cache copy.
+    void* map = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) return false;
+
+    const AttackTableHeader* header = map;
+    const bool valid = memcmp(header->tag, ATTACK_TABLE_TAG, sizeof(header->tag)) == 0
+                    && header->version == ATTACK_TABLE_VERSION
+                    && header->endian == ATTACK_TABLE_ENDIAN
+                    && header->header_size == sizeof(AttackTableHeader)
+                    && header->attacks_offset % 64 == 0
+                    && header->index_offset % 64 == 0
+                    && header->pext_offset % 64 == 0
+                    && header->attack_count == SLIDER_ATTACK_COUNT
+                    && header->index_count <= SLIDER_INDEX_LIMIT
+                    && (size_t)header->attacks_offset + (size_t)header->attack_count * 8 <= (size_t)st.st_size
+                    && (size_t)header->index_offset + header->index_count <= (size_t)st.st_size
+                    && (size_t)header->pext_offset + PEXT_INDEX_SIZE <= (size_t)st.st_size;
+    if (!valid) {
+        munmap(map, (size_t)st.st_size);
+        return false;
+    }
+
+    const uint64_t* attacks = (const uint64_t*)((const char*)map + header->attacks_offset);
+    const uint8_t* index = (const uint8_t*)map + header->index_offset;
+    const uint8_t* pext_index = (const uint8_t*)map + header->pext_offset;
+#ifdef CHESS_DEBUG_CHECKS
+    // Reading every page defeats the point of mapping, so only debug builds do it.
+    if (attack_table_checksum(header, attacks, index, pext_index) != header->checksum) {
+        fprintf(stderr, "Attack table checksum mismatch in %s\n", path);
+        munmap(map, (size_t)st.st_size);
+        return false;
+    }
+#endif
+
+    ROOK_MAGICS = header->rook;
+    BISHOP_MAGICS = header->bishop;
+    SLIDER_ATTACKS = attacks;
+    SLIDER_INDEX = index;
+    PEXT_INDEX = pext_index;
+    return true;
+#endif
+}
+
+uint32_t build_attack_tables(void) {
+    const uint32_t index_count = build_slider_tables(rook_storage, bishop_storage, index_storage, pext_storage,
+                                                     attack_storage);
+    ROOK_MAGICS = rook_storage;
+    BISHOP_MAGICS = bishop_storage;
+    SLIDER_ATTACKS = attack_storage;
+    SLIDER_INDEX = index_storage;
+    PEXT_INDEX = pext_storage;
+    init_steps();
+    init_lines();
+    return index_count;
+}
+
+void init_attacks(void) {
+    const char* path = getenv("CHESS_ATTACK_TABLES");
+    if (load_attack_tables(path ? path : ATTACK_TABLE_PATH)) {
+        init_steps();
+        init_lines();
+    } else {
+        if (path) fprintf(stderr, "Could not map attack tables from %s, building them in memory\n", path);
+        build_attack_tables();
+    }
+    init_slider_backend();
+}
+#else
+void init_attacks(void) {
+    init_slider_backend();
+}
+#endif
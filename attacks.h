@@ -0,0 +1,153 @@
+//
+// Created by lenovo on 10/18/2026.
+//
+
+#ifndef ATTACKS_H
+#define ATTACKS_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+// Per-square magic lookup for a sliding piece. The magic index selects a byte in this
+// square's window of SLIDER_INDEX, which numbers the square's distinct attack sets:
+//   SLIDER_ATTACKS[attacks + SLIDER_INDEX[offset + (((occupancy & mask) * magic) >> shift)]]
+// A square has at most 144 distinct attack sets, so one byte per slot is enough, and the
+// windows of different squares overlap wherever their slots are unused or agree.
+// The PEXT backend indexes PEXT_INDEX[pext_offset + pext(occupancy, mask)] instead, with
+// the same numbering, so both share SLIDER_ATTACKS.
+// The byte index is a second, dependent load per lookup (about 2 ns in bench_attacks),
+// paid for a table a fifth the size of one attack set per magic index.
+typedef struct {
+    uint64_t mask;          // relevant occupancy: ray squares minus the board edge
+    uint64_t magic;
+    uint32_t offset;        // start of this square's window in SLIDER_INDEX
+    uint32_t attacks;       // first of this square's distinct attack sets in SLIDER_ATTACKS
+    uint32_t shift;         // 64 - relevant bits
+    uint32_t pext_offset;   // start of this square's window in PEXT_INDEX
+} Magic;
+
+// Relevant-occupancy subsets per piece, which is also the unpacked table size when every
+// square's magic index has as many bits as it has relevant squares (see bench_attacks).
+// A magic.h with fewer index bits for some square would shrink its window below this;
+// magic_number_generator only produces full-width magics.
+#define ROOK_TABLE_SIZE    102400
+#define BISHOP_TABLE_SIZE  5248
+#define SLIDER_TABLE_SIZE  (ROOK_TABLE_SIZE + BISHOP_TABLE_SIZE)
+
+// Distinct attack sets over all squares (4900 rook + 1428 bishop), and the upper
+// bound on the packed index, reached only if no two windows overlap.
+#define SLIDER_ATTACK_COUNT 6328
+#define SLIDER_INDEX_LIMIT  SLIDER_TABLE_SIZE
+// PEXT indices are dense: one byte per relevant-occupancy subset.
+#define PEXT_INDEX_SIZE     SLIDER_TABLE_SIZE
+
+// === Attack table file ===
+// Written by generate_attack_tables, mapped read-only by the engine. Everything
+// is stored in host byte order so the mapping is used in place, without parsing:
+// the header is followed by `attack_count` uint64_t attack sets at `attacks_offset` and
+// `index_count` index bytes at `index_offset`, then PEXT_INDEX_SIZE bytes at `pext_offset`.
+#define ATTACK_TABLE_PATH     "bin/attacks.bin"
+#define ATTACK_TABLE_TAG      "CHESSATK"
+#define ATTACK_TABLE_VERSION  3
+#define ATTACK_TABLE_ENDIAN   0x01020304U
+
+typedef struct {
+    char tag[8];
+    uint32_t version;
+    uint32_t endian;            // ATTACK_TABLE_ENDIAN as written by the generator
+    uint32_t header_size;       // sizeof(AttackTableHeader)
+    uint32_t attacks_offset;    // byte offset of the attack sets, cache-line aligned
+    uint32_t attack_count;
+    uint32_t index_offset;      // byte offset of SLIDER_INDEX, cache-line aligned
+    uint32_t index_count;
+    uint32_t pext_offset;       // byte offset of PEXT_INDEX, cache-line aligned
+    uint64_t checksum;          // attack_table_checksum() of the magics, attack sets and indices
+    Magic rook[64];
+    Magic bishop[64];
+} AttackTableHeader;
+
+#ifdef CHESS_EMBED_TABLES
+// Generated at build time by generate_attack_tables into attack_tables.c and
+// linked in as .rodata: no startup work, no file I/O.
+#define ATTACK_TABLE const
+extern const Magic ROOK_MAGICS[64];
+extern const Magic BISHOP_MAGICS[64];
+extern const uint64_t SLIDER_ATTACKS[SLIDER_ATTACK_COUNT];
+extern const uint8_t SLIDER_INDEX[];
+extern const uint8_t PEXT_INDEX[PEXT_INDEX_SIZE];
+#else
+#define ATTACK_TABLE
+extern const Magic* ROOK_MAGICS;
+extern const Magic* BISHOP_MAGICS;
+extern const uint64_t* SLIDER_ATTACKS;
+extern const uint8_t* SLIDER_INDEX;
+extern const uint8_t* PEXT_INDEX;
+#endif
+
+// Step attacks per square. PAWN_ATTACKS[side][sq] are the squares a `side` pawn on `sq` captures on.
+extern ATTACK_TABLE uint64_t KNIGHT_ATTACKS[64];
+extern ATTACK_TABLE uint64_t KING_ATTACKS[64];
+extern ATTACK_TABLE uint64_t PAWN_ATTACKS[2][64];
+
+// BETWEEN[a][b]: squares strictly between two aligned squares, 0 if not aligned.
+// LINE[a][b]: the whole rank, file or diagonal through both squares, 0 if not aligned.
+extern ATTACK_TABLE uint64_t BETWEEN[64][64];
+extern ATTACK_TABLE uint64_t LINE[64][64];
+
+// Maps the table file (CHESS_ATTACK_TABLES, else ATTACK_TABLE_PATH) and falls back
+// to building the tables in memory from magic.h when it is missing or stale, then
+// picks the slider backend. Call once at startup, before any lookup.
+void init_attacks(void);
+
+// === Slider backends ===
+// rook_attacks/bishop_attacks are pointers set once by init_attacks from CPUID: PEXT
+// where the CPU has a fast PEXT, magics otherwise. CHESS_SLIDERS=magic|pext overrides
+// the choice, for testing.
+typedef enum {
+    SLIDERS_MAGIC,
+    SLIDERS_PEXT,
+} SliderBackend;
+
+typedef uint64_t (*SliderAttacks)(int sq, uint64_t occupancy);
+
+extern SliderAttacks rook_attacks;
+extern SliderAttacks bishop_attacks;
+
+// True if the CPU has BMI2 and its PEXT isn't microcoded (AMD before Zen 3).
+bool pext_is_fast(void);
+
+// Points the lookups at `backend`. Returns false, changing nothing, if the CPU
+// (or this build) can't run it.
+bool select_slider_backend(SliderBackend backend);
+SliderBackend slider_backend(void);
+const char* slider_backend_name(SliderBackend backend);
+
+#ifndef CHESS_EMBED_TABLES
+// Builds every table in memory, ignoring any table file. Returns the packed index size.
+uint32_t build_attack_tables(void);
+
+// Maps `path` read-only and points the lookups at it. Returns false, leaving the
+// current tables in place, if the file is missing or its header doesn't match.
+bool load_attack_tables(const char* path);
+#endif
+
+// Builds the packed magic tables from the constants in magic.h into caller storage
+// (`index` needs SLIDER_INDEX_LIMIT bytes, `pext_index` PEXT_INDEX_SIZE bytes, `attacks`
+// SLIDER_ATTACK_COUNT entries) and returns the packed index size. Used by the fallback
+// and the generator.
+uint32_t build_slider_tables(Magic* rook, Magic* bishop, uint8_t* index, uint8_t* pext_index, uint64_t* attacks);
+
+// Same magics with one attack set per magic index and square (`attacks` needs
+// SLIDER_TABLE_SIZE entries; `offset` is into `attacks`). Returns the entries used.
+// Only kept for benchmarking.
+uint32_t build_dense_slider_tables(Magic* rook, Magic* bishop, uint64_t* attacks);
+
+uint64_t attack_table_checksum(const AttackTableHeader* header, const uint64_t* attacks, const uint8_t* index,
+                               const uint8_t* pext_index);
+
+static inline uint64_t queen_attacks(int sq, uint64_t occupancy) {
+    return rook_attacks(sq, occupancy) | bishop_attacks(sq, occupancy);
+}
+
+#endif //ATTACKS_H
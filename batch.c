@@ -0,0 +1,222 @@
+//
+// Created by lenovo on 10/18/2026.
+//
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include "constants.h"
+#include "bitboard.h"
+#include "move.h"
+#include "movegeneration.h"
+#include "eval.h"
+#include "pawns.h"
+#include "nnue.h"
+#include "search.h"
+#include "threadpool.h"
+#include "tt.h"
+#include "utils.h"
+#include "batch.h"
+
+// One per pool worker, created on first use and kept.
+typedef struct {
+    PawnTable pawns;
+    EvalState eval;
+    NnueAccumulator accumulator;    // a root entry is all a static eval needs
+    SearchThread* search;           // created by the first search batch
+} BatchScratch;
+
+static BatchScratch* batch_scratch[BATCH_MAX_THREADS];
+
+typedef struct {
+    const char* const* fens;
+    const Bitboard* positions;
+    Bitboard* parsed;
+    const bool* valid;
+    bool* parsed_valid;
+    size_t count;
+    size_t block;               // positions per task
+    int depth;
+    int* scores;
+    move16* best_moves;
+} BatchJob;
+
+static int clamp_threads(int threads) {
+    if (threads < 1) return 1;
+    return threads > BATCH_MAX_THREADS ? BATCH_MAX_THREADS : threads;
+}
+
+static void prepare_scratch(const int threads, const bool search) {
+    for (int i = 0; i < threads; i++) {
+        if (!batch_scratch[i]) {
+            // Zeroed: an all-zero pawn entry is the valid entry for pawn_key 0.
+            batch_scratch[i] = calloc(1, sizeof(BatchScratch));
+            if (!batch_scratch[i]) {
+                fprintf(stderr, "Failed to allocate batch scratch state\n");
+                exit(EXIT_FAILURE);
+            }
+            batch_scratch[i]->eval.pawns = &batch_scratch[i]->pawns;
+        }
+        if (search && !batch_scratch[i]->search) batch_scratch[i]->search = search_thread_create();
+    }
+}
+
+static size_t block_count(const BatchJob* job) {
+    return (job->count + job->block - 1) / job->block;
+}
+
+static void block_range(const BatchJob* job, const size_t block, size_t* first, size_t* last) {
+    *first = block * job->block;
+    *last = *first + job->block < job->count ? *first + job->block : job->count;
+}
+
+// --- Parsing ---
+
+static void parse_block(void* context, const size_t block, int worker) {
+    (void)worker;
+    const BatchJob* job = context;
+    size_t first, last;
+    block_range(job, block, &first, &last);
+    for (size_t i = first; i < last; i++) {
+        Bitboard* b = &job->parsed[i];
+        job->parsed_valid[i] = try_init_Bitboard(job->fens[i], b) && position_is_legal(b);
+    }
+}
+
+void batch_parse(const char* const* fens, const size_t count, Bitboard* positions, bool* valid, const int threads) {
+    BatchJob job = {.fens = fens, .parsed = positions, .parsed_valid = valid, .count = count, .block = BATCH_BLOCK};
+    threadpool_run(clamp_threads(threads), block_count(&job), parse_block, &job);
+}
+
+// --- Static evaluation ---
+
+static void evaluate_block(void* context, const size_t block, const int worker) {
+    const BatchJob* job = context;
+    BatchScratch* s = batch_scratch[worker];
+    const bool nnue = nnue_enabled();
+    size_t first, last;
+    block_range(job, block, &first, &last);
+    for (size_t i = first; i < last; i++) {
+        if (job->valid && !job->valid[i]) {
+            job->scores[i] = 0;
+            continue;
+        }
+        Bitboard board = job->positions[i];
+        board.nnue = NULL;
+        if (nnue) nnue_attach(&board, &s->accumulator);     // a full refresh, with the AVX2 kernels if available
+        job->scores[i] = evaluate_position(&board, &s->eval);
+    }
+}
+
+void batch_evaluate(const Bitboard* positions, const bool* valid, const size_t count, int* scores, int threads) {
+    threads = clamp_threads(threads);
+    prepare_scratch(threads, false);
+    BatchJob job = {.positions = positions, .valid = valid, .count = count, .block = BATCH_BLOCK, .scores = scores};
+    threadpool_run(threads, block_count(&job), evaluate_block, &job);
+}
+
+// --- Fixed-depth search ---
+
+static void search_block(void* context, const size_t block, const int worker) {
+    const BatchJob* job = context;
+    SearchThread* t = batch_scratch[worker]->search;
+    size_t first, last;
+    block_range(job, block, &first, &last);
+    for (size_t i = first; i < last; i++) {
+        move16 best = MOVE_NONE;
+        if (job->valid && !job->valid[i]) job->scores[i] = 0;
+        else job->scores[i] = search_fixed_depth(t, &job->positions[i], job->depth, &best);
+        if (job->best_moves) job->best_moves[i] = best;
+    }
+}
+
+void batch_search(const Bitboard* positions, const bool* valid, const size_t count, const int depth, int* scores,
+                  move16* best_moves, int threads) {
+    threads = clamp_threads(threads);
+    prepare_scratch(threads, true);
+    if (!TT.buckets) tt_resize(16);
+    tt_new_search();
+    // Searches vary too much in size for blocks: one position per task balances better.
+    BatchJob job = {.positions = positions, .valid = valid, .count = count, .block = 1, .depth = depth,
+                    .scores = scores, .best_moves = best_moves};
+    threadpool_run(threads, block_count(&job), search_block, &job);
+}
+
+// --- FEN files ---
+
+bool batch_score_file(const char* path, const int depth, const int threads) {
+    FILE* file = fopen(path, "rb");
+    if (!file) return false;
+    // Pipes and other unseekable files report -1.
+    const long size = fseek(file, 0, SEEK_END) == 0 ? ftell(file) : -1;
+    if (size < 0 || fseek(file, 0, SEEK_SET) != 0) {
+        fclose(file);
+        return false;
+    }
+    char* text = malloc((size_t)size + 1);
+    if (!text || fread(text, 1, (size_t)size, file) != (size_t)size) {
+        fclose(file);
+        free(text);
+        return false;
+    }
+    fclose(file);
+    text[size] = '\0';
+
+    // One FEN per non-empty line, split in place.
+    size_t count = 0;
+    for (long i = 0; i < size; i++) count += text[i] == '\n';
+    count++;
+    const char** fens = malloc(count * sizeof(char*));
+    Bitboard* positions = malloc(count * sizeof(Bitboard));
+    int* scores = malloc(count * sizeof(int));
+    move16* best_moves = malloc(count * sizeof(move16));
+    bool* valid = malloc(count * sizeof(bool));
+    if (!fens || !positions || !scores || !best_moves || !valid) {
+        fprintf(stderr, "Failed to allocate %zu positions\n", count);
+        exit(EXIT_FAILURE);
+    }
+    count = 0;
+    for (char* line = text; line && *line; ) {
+        char* end = strchr(line, '\n');
+        if (end) *end = '\0';
+        size_t length = strlen(line);
+        if (length && line[length - 1] == '\r') line[--length] = '\0';
+        if (length) fens[count++] = line;
+        line = end ? end + 1 : NULL;
+    }
+
+    uint64_t start = time_now_ns();
+    batch_parse(fens, count, positions, valid, threads);
+    const uint64_t parse_ns = time_now_ns() - start;
+    start = time_now_ns();
+    if (depth > 0) batch_search(positions, valid, count, depth, scores, best_moves, threads);
+    else batch_evaluate(positions, valid, count, scores, threads);
+    const uint64_t score_ns = time_now_ns() - start;
+
+    char move[6];
+    size_t rejected = 0;
+    for (size_t i = 0; i < count; i++) {
+        if (!valid[i]) {
+            printf("invalid\n");
+            rejected++;
+        } else if (depth > 0) {
+            move_to_string(best_moves[i], move);
+            printf("%d %s\n", scores[i], best_moves[i] ? move : "0000");
+        } else {
+            printf("%d\n", scores[i]);
+        }
+    }
+    if (rejected) fprintf(stderr, "%zu of %zu lines are not legal positions\n", rejected, count);
+    fprintf(stderr, "%zu positions: parse %.0f positions/s, %s %.0f positions/s\n", count,
+            parse_ns ? (double)count * 1e9 / (double)parse_ns : 0.0, depth > 0 ? "search" : "static eval",
+            score_ns ? (double)count * 1e9 / (double)score_ns : 0.0);
+
+    free(valid);
+    free(best_moves);
+    free(scores);
+    free(positions);
+    free(fens);
+    free(text);
+    return true;
+}
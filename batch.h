@@ -0,0 +1,42 @@
+//
+// Created by lenovo on 10/18/2026.
+//
+
+#ifndef BATCH_H
+#define BATCH_H
+
+#include <stddef.h>
+#include <stdbool.h>
+#include "bitboard.h"
+#include "move.h"
+
+// === Batch scoring ===
+// Scores large sets of independent positions on the thread pool, BATCH_BLOCK
+// positions per task (one per task for searches). Each worker keeps its scratch
+// state (pawn table, NNUE accumulator, search stack) from one batch to the next,
+// so nothing is allocated per position. Scores are centipawns from the side to
+// move's point of view.
+#define BATCH_BLOCK        64
+#define BATCH_MAX_THREADS  256
+
+// Parses `fens` into `positions` (caller-owned, `count` long). valid[i] is false
+// where fens[i] is malformed or not a legal position (see position_is_legal); a
+// bad line never stops the batch.
+void batch_parse(const char* const* fens, size_t count, Bitboard* positions, bool* valid, int threads);
+
+// Static evaluation, through the NNUE when one is loaded. Positions whose `valid`
+// entry is false score 0; `valid` may be NULL when all are.
+void batch_evaluate(const Bitboard* positions, const bool* valid, size_t count, int* scores, int threads);
+
+// Fixed-depth alpha-beta search of each position on its own. The workers share
+// the transposition table. `valid` as above; `best_moves` may be NULL.
+void batch_search(const Bitboard* positions, const bool* valid, size_t count, int depth, int* scores,
+                  move16* best_moves, int threads);
+
+// Scores every FEN line of `path` (static eval at depth 0), printing one
+// "score [bestmove]" line per position, or "invalid" for a line that is not a
+// legal position, to stdout and the rates to stderr. Returns false if the file
+// can't be read.
+bool batch_score_file(const char* path, int depth, int threads);
+
+#endif //BATCH_H
@@ -0,0 +1,465 @@
+//
+// Created by lenovo on 10/18/2026.
+//
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include "constants.h"
+#include "bitboard.h"
+#include "move.h"
+#include "movegeneration.h"
+#include "attacks.h"
+#include "utils.h"
+#include "search.h"
+#include "tt.h"
+#include "threadpool.h"
+#include "eval.h"
+#include "nnue.h"
+#include "see.h"
+#include "mcts.h"
+#include "batch.h"
+
+#define BENCH_QUERIES (1 << 16)   // power of two
+#define BENCH_GAME_PLIES 120
+
+static const char* BENCH_START = "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1";
+
+typedef struct {
+    uint64_t occupancy;
+    uint8_t sq;
+    uint8_t rook;
+} SliderQuery;
+
+static uint64_t bench_random(uint64_t* state) {
+    uint64_t z = (*state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+// One query per rook, bishop and queen line for every position of random games
+// played from the start position, so occupancy density and piece placement follow
+// real play rather than uniformly random bits.
+static void sample_queries(SliderQuery* queries, size_t count) {
+    uint64_t rng = 0x5EED;
+    size_t n = 0;
+    while (n < count) {
+        Bitboard board = init_Bitboard(BENCH_START);
+        Bitboard* b = &board;
+        for (int ply = 0; ply < BENCH_GAME_PLIES && n < count; ply++) {
+            MoveList list;
+            list.count = 0;
+            generate_legal_moves(b, &list);
+            if (list.count == 0) break;
+
+            for (int side = 0; side < 2; side++) {
+                const uint64_t* p = &b->pieces[INDEX_OF(side, INDEX_PAWN)];
+                uint64_t rooks = p[INDEX_ROOK] | p[INDEX_QUEEN];
+                uint64_t bishops = p[INDEX_BISHOP] | p[INDEX_QUEEN];
+                while (rooks && n < count) queries[n++] = (SliderQuery){b->all_occupancy, (uint8_t)pop_lsb(&rooks), 1};
+                while (bishops && n < count) queries[n++] = (SliderQuery){b->all_occupancy, (uint8_t)pop_lsb(&bishops), 0};
+            }
+
+            Undo undo;
+            make_move(b, list.moves[bench_random(&rng) % list.count], &undo);
+        }
+    }
+
+    // Shuffle so consecutive lookups don't walk the same position.
+    for (size_t i = count - 1; i > 0; i--) {
+        const size_t j = bench_random(&rng) % (i + 1);
+        const SliderQuery q = queries[i];
+        queries[i] = queries[j];
+        queries[j] = q;
+    }
+}
+
+static uint64_t dense_lookup(const Magic* m, const uint64_t* attacks, uint64_t occupancy) {
+    return attacks[m->offset + (((occupancy & m->mask) * m->magic) >> m->shift)];
+}
+
+#define BENCH_NOISE_BYTES (16u << 20)   // power of two, larger than L2
+
+static void report(const char* name, size_t bytes, uint64_t lookups, uint64_t elapsed_ns, uint64_t checksum) {
+    printf("  %-8s %7.1f KB  %6.2f ns/lookup  %6.1f M lookups/s  (checksum %016llx)\n", name, (double)bytes / 1024.0,
+           (double)elapsed_ns / (double)lookups, (double)lookups * 1e3 / (double)elapsed_ns,
+           (unsigned long long)checksum);
+}
+
+// The same walk for both layouts: the next query depends on the last attack set. With
+// `noise`, every lookup also reads a random cache line of a large buffer, standing in
+// for the hash table and other traffic that competes for cache during a search.
+#define BENCH_WALK(lookup, noise) do {                                                \
+    checksum = 0, i = 0;                                                              \
+    start = time_now_ns();                                                            \
+    for (uint64_t n = 0; n < lookups; n++) {                                          \
+        const SliderQuery* q = &queries[i];                                           \
+        const uint64_t attacks = (lookup);                                            \
+        if (noise) checksum += noise_buffer[((attacks * 0x9E3779B97F4A7C15ULL) >> 32) \
+                                            & (BENCH_NOISE_BYTES / 8 - 1) & ~7ULL];   \
+        checksum += attacks;                                                          \
+        i = (i + 1 + (attacks & 1)) & (BENCH_QUERIES - 1);                            \
+    }                                                                                 \
+} while (0)
+
+void bench_attacks(const uint64_t lookups) {
+    SliderQuery* queries = malloc(BENCH_QUERIES * sizeof(SliderQuery));
+    uint64_t* dense = malloc(SLIDER_TABLE_SIZE * sizeof(uint64_t));
+    uint64_t* noise_buffer = malloc(BENCH_NOISE_BYTES);
+    Magic dense_rook[64], dense_bishop[64];
+    if (!queries || !dense || !noise_buffer) {
+        fprintf(stderr, "Failed to allocate benchmark tables\n");
+        exit(EXIT_FAILURE);
+    }
+    // Written, not calloc'ed: untouched pages all map the same zero page and never miss.
+    for (size_t n = 0; n < BENCH_NOISE_BYTES / 8; n++) noise_buffer[n] = n;
+    sample_queries(queries, BENCH_QUERIES);
+    const size_t dense_bytes = build_dense_slider_tables(dense_rook, dense_bishop, dense) * sizeof(uint64_t);
+
+    uint32_t index_count = 0;
+    for (int sq = 0; sq < 64; sq++) {
+        const Magic* magics[2] = {&ROOK_MAGICS[sq], &BISHOP_MAGICS[sq]};
+        for (int k = 0; k < 2; k++) {
+            const uint32_t end = magics[k]->offset + (1U << (64 - magics[k]->shift));
+            if (end > index_count) index_count = end;
+        }
+    }
+    const size_t packed_bytes = SLIDER_ATTACK_COUNT * sizeof(uint64_t) + index_count;
+    const size_t pext_bytes = SLIDER_ATTACK_COUNT * sizeof(uint64_t) + PEXT_INDEX_SIZE;
+    const SliderBackend selected = slider_backend();
+    printf("Selected backend: %s (fast PEXT: %s)\n", slider_backend_name(selected), pext_is_fast() ? "yes" : "no");
+
+    uint64_t checksum, i, start;
+    for (int noise = 0; noise < 2; noise++) {
+        printf(noise ? "With a random 16 MB read per lookup:\n" : "Tables only:\n");
+
+        BENCH_WALK(dense_lookup(q->rook ? &dense_rook[q->sq] : &dense_bishop[q->sq], dense, q->occupancy), noise);
+        report("dense", dense_bytes, lookups, time_now_ns() - start, checksum);
+
+        // Through the dispatched pointers, as the engine calls them.
+        for (int backend = SLIDERS_MAGIC; backend <= SLIDERS_PEXT; backend++) {
+            if (!select_slider_backend((SliderBackend)backend)) continue;
+            BENCH_WALK(q->rook ? rook_attacks(q->sq, q->occupancy) : bishop_attacks(q->sq, q->occupancy), noise);
+            report(slider_backend_name((SliderBackend)backend), backend == SLIDERS_PEXT ? pext_bytes : packed_bytes,
+                   lookups, time_now_ns() - start, checksum);
+        }
+    }
+    select_slider_backend(selected);
+
+    free(noise_buffer);
+    free(dense);
+    free(queries);
+}
+
+// --- Search bench ---
+
+static const char* BENCH_POSITIONS[] = {
+    "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+    "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+    "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+    "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+    "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8",
+    "r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10",
+    "r1bq1rk1/pp2bppp/2n1pn2/3p4/2PP4/2N1PN2/PP1B1PPP/R2QKB1R w KQ - 0 8",
+    "r1bqkb1r/pppp1ppp/2n2n2/4p3/2B1P3/5N2/PPPP1PPP/RNBQK2R w KQkq - 4 4",
+    "8/8/4k3/3p4/3P4/4K3/8/8 w - - 0 50",
+    "4rrk1/pp1n3p/3q2pQ/2p1pb2/2PP4/2P3N1/P2B2PP/4RRK1 b - - 7 19",
+};
+
+uint64_t bench_search(const int depth) {
+    const size_t count = sizeof(BENCH_POSITIONS) / sizeof(BENCH_POSITIONS[0]);
+    const SearchLimits limits = {.depth = depth, .quiet = true};
+    uint64_t total_nodes = 0, total_ns = 0, pawn_probes = 0, pawn_hits = 0, eval_probes = 0, eval_hits = 0;
+    uint64_t cutoffs = 0, first_move_cutoffs = 0, total_qnodes = 0;
+
+    for (size_t i = 0; i < count; i++) {
+        const Bitboard board = init_Bitboard(BENCH_POSITIONS[i]);
+        SearchResult result;
+        tt_clear();
+        search_position(&board, NULL, 0, &limits, &result);
+
+        char move[6], score[SCORE_STR_LEN];
+        move_to_string(result.best_move, move);
+        format_score(result.score, score, sizeof(score));
+        printf("%2zu  depth %2d  %-9s  best %-5s  nodes %10llu  qnodes %10llu  time %7.3f s\n", i + 1, result.depth,
+               score, move, (unsigned long long)result.nodes, (unsigned long long)result.qnodes,
+               (double)result.time_ns / 1e9);
+        total_nodes += result.nodes;
+        total_qnodes += result.qnodes;
+        total_ns += result.time_ns;
+        pawn_probes += result.pawn_probes;
+        pawn_hits += result.pawn_hits;
+        eval_probes += result.eval_probes;
+        eval_hits += result.eval_hits;
+        cutoffs += result.cutoffs;
+        first_move_cutoffs += result.first_move_cutoffs;
+    }
+
+    if (pawn_probes) printf("Pawn hash: %.1f%% hits of %llu probes\n", 100.0 * (double)pawn_hits / (double)pawn_probes,
+                            (unsigned long long)pawn_probes);
+    if (eval_probes) printf("Eval cache: %llu hits, %llu misses (%.1f%%)\n", (unsigned long long)eval_hits,
+                            (unsigned long long)(eval_probes - eval_hits),
+                            100.0 * (double)eval_hits / (double)eval_probes);
+    if (total_nodes) printf("Quiescence: %llu of the nodes (%.1f%%)\n", (unsigned long long)total_qnodes,
+                            100.0 * (double)total_qnodes / (double)total_nodes);
+    if (cutoffs) printf("Cutoffs: %.1f%% by the first move of %llu\n",
+                        100.0 * (double)first_move_cutoffs / (double)cutoffs, (unsigned long long)cutoffs);
+    printf("Nodes: %llu  Time: %.3f s  NPS: %.0f\n", (unsigned long long)total_nodes, (double)total_ns / 1e9,
+           total_ns ? (double)total_nodes * 1e9 / (double)total_ns : 0.0);
+    return total_nodes;
+}
+
+uint64_t bench_smp(const int depth, int max_threads) {
+    const size_t count = sizeof(BENCH_POSITIONS) / sizeof(BENCH_POSITIONS[0]);
+    if (max_threads < 1) max_threads = 1;
+    if (max_threads > MAX_SEARCH_THREADS) max_threads = MAX_SEARCH_THREADS;
+    printf("Time to depth %d over %zu positions, %d CPUs online\n", depth, count, threadpool_cpu_count());
+
+    uint64_t base_ns = 0, total_nodes = 0;
+    for (int threads = 1; threads <= max_threads; threads *= 2) {
+        const SearchLimits limits = {.depth = depth, .threads = threads, .quiet = true};
+        uint64_t nodes = 0, ns = 0;
+        for (size_t i = 0; i < count; i++) {
+            const Bitboard board = init_Bitboard(BENCH_POSITIONS[i]);
+            SearchResult result;
+            tt_clear();
+            search_position(&board, NULL, 0, &limits, &result);
+            nodes += result.nodes;
+            ns += result.time_ns;
+        }
+        if (threads == 1) base_ns = ns;
+        printf("threads %3d  nodes %11llu  time %8.3f s  NPS %10.0f  speedup %5.2f\n", threads,
+               (unsigned long long)nodes, (double)ns / 1e9, ns ? (double)nodes * 1e9 / (double)ns : 0.0,
+               ns ? (double)base_ns / (double)ns : 0.0);
+        total_nodes += nodes;
+    }
+    return total_nodes;
+}
+
+// --- Evaluation bench ---
+
+#define BENCH_EVAL_PLIES 40
+
+typedef enum {
+    EVAL_NONE,              // the walk alone, subtracted from the others
+    EVAL_HANDCRAFTED,
+    EVAL_NNUE,              // accumulators updated from the parent
+    EVAL_NNUE_REFRESH,      // accumulators recomputed for every evaluation
+} EvalMode;
+
+// Every child of every position along random games from the bench positions is
+// made, evaluated and unmade, as at the leaves of a search. The games depend only
+// on `round`, so every mode evaluates the same positions.
+static uint64_t eval_walk(const EvalMode mode, const int rounds, int64_t* sum) {
+    static NnueAccumulator stack[BENCH_EVAL_PLIES + 2];
+    const size_t count = sizeof(BENCH_POSITIONS) / sizeof(BENCH_POSITIONS[0]);
+    uint64_t evals = 0;
+    *sum = 0;
+
+    for (int round = 0; round < rounds; round++) {
+        uint64_t rng = 0x5EED + (uint64_t)round;
+        for (size_t p = 0; p < count; p++) {
+            Bitboard board = init_Bitboard(BENCH_POSITIONS[p]);
+            if (mode == EVAL_NNUE) nnue_attach(&board, stack);
+
+            for (int ply = 0; ply < BENCH_EVAL_PLIES; ply++) {
+                MoveList list;
+                list.count = 0;
+                generate_legal_moves(&board, &list);
+                if (list.count == 0) break;
+
+                for (size_t i = 0; i < list.count; i++) {
+                    Undo undo;
+                    make_move(&board, list.moves[i], &undo);
+                    if (mode == EVAL_NNUE_REFRESH) nnue_attach(&board, stack);
+                    if (mode != EVAL_NONE) *sum += evaluate_position(&board, NULL);
+                    if (mode == EVAL_NNUE_REFRESH) board.nnue = NULL;
+                    unmake_move(&board, list.moves[i], &undo);
+                    evals++;
+                }
+
+                Undo undo;
+                make_move(&board, list.moves[bench_random(&rng) % list.count], &undo);
+            }
+        }
+    }
+    return evals;
+}
+
+void bench_eval(const char* network, const int rounds) {
+    if (network ? !nnue_load(network) : !nnue_enabled() && !nnue_load(NNUE_PATH)) {
+        fprintf(stderr, "No network: pass one, set CHESS_NNUE, or write %s with `chess nnue-export %s`\n",
+                NNUE_PATH, NNUE_PATH);
+        return;
+    }
+    const bool avx2 = nnue_avx2();
+    int64_t sum;
+    uint64_t start = time_now_ns();
+    const uint64_t evals = eval_walk(EVAL_NONE, rounds, &sum);
+    const uint64_t walk_ns = time_now_ns() - start;
+    printf("%llu evaluations; walk overhead %.1f ns per evaluation, subtracted below\n", (unsigned long long)evals,
+           (double)walk_ns / (double)evals);
+
+    const struct {
+        const char* name;
+        EvalMode mode;
+        bool avx2;
+    } runs[] = {
+        {"handcrafted", EVAL_HANDCRAFTED, avx2},
+        {"nnue incremental avx2", EVAL_NNUE, true},
+        {"nnue incremental scalar", EVAL_NNUE, false},
+        {"nnue refresh avx2", EVAL_NNUE_REFRESH, true},
+        {"nnue refresh scalar", EVAL_NNUE_REFRESH, false},
+    };
+    for (size_t r = 0; r < sizeof(runs) / sizeof(runs[0]); r++) {
+        if (!nnue_use_avx2(runs[r].avx2)) continue;
+        start = time_now_ns();
+        eval_walk(runs[r].mode, rounds, &sum);
+        const uint64_t elapsed = time_now_ns() - start;
+        const double ns = elapsed > walk_ns ? (double)(elapsed - walk_ns) / (double)evals : 0.0;
+        printf("  %-24s %8.1f ns/eval  %8.2f M evals/s  (sum %lld)\n", runs[r].name, ns, ns > 0 ? 1e3 / ns : 0.0,
+               (long long)sum);
+    }
+    nnue_use_avx2(avx2);
+}
+
+// --- SEE bench ---
+
+#define BENCH_SEE_CAPTURES (1 << 16)
+
+typedef struct {
+    Bitboard board;
+    move16 move;
+} SeeQuery;
+
+void bench_see(const uint64_t calls) {
+    SeeQuery* queries = malloc(BENCH_SEE_CAPTURES * sizeof(SeeQuery));
+    if (!queries) {
+        fprintf(stderr, "Failed to allocate benchmark positions\n");
+        exit(EXIT_FAILURE);
+    }
+
+    // Every capture of every position along random games from the start position.
+    uint64_t rng = 0x5EED;
+    size_t n = 0;
+    while (n < BENCH_SEE_CAPTURES) {
+        Bitboard board = init_Bitboard(BENCH_START);
+        for (int ply = 0; ply < BENCH_GAME_PLIES && n < BENCH_SEE_CAPTURES; ply++) {
+            MoveList list;
+            list.count = 0;
+            generate_legal_moves(&board, &list);
+            if (list.count == 0) break;
+            for (size_t i = 0; i < list.count && n < BENCH_SEE_CAPTURES; i++) {
+                if (IS_CAPTURE(&board, list.moves[i])) queries[n++] = (SeeQuery){board, list.moves[i]};
+            }
+            Undo undo;
+            make_move(&board, list.moves[bench_random(&rng) % list.count], &undo);
+        }
+    }
+
+    int64_t checksum = 0;
+    uint64_t losing = 0;
+    const uint64_t start = time_now_ns();
+    for (uint64_t c = 0; c < calls; c++) {
+        const SeeQuery* q = &queries[c & (BENCH_SEE_CAPTURES - 1)];
+        const int value = see(&q->board, q->move);
+        checksum += value;
+        losing += value < 0;
+    }
+    const uint64_t elapsed = time_now_ns() - start;
+    printf("%llu SEE calls over %d captures from random games: %.1f ns/call, %.1f%% losing (checksum %lld)\n",
+           (unsigned long long)calls, BENCH_SEE_CAPTURES, (double)elapsed / (double)calls,
+           100.0 * (double)losing / (double)calls, (long long)checksum);
+    free(queries);
+}
+
+// --- MCTS bench ---
+
+void bench_mcts(const uint64_t playouts, int max_threads) {
+    const size_t count = sizeof(BENCH_POSITIONS) / sizeof(BENCH_POSITIONS[0]);
+    if (max_threads < 1) max_threads = 1;
+    if (max_threads > MCTS_MAX_THREADS) max_threads = MCTS_MAX_THREADS;
+    printf("%llu playouts per position over %zu positions, %d CPUs online\n", (unsigned long long)playouts, count,
+           threadpool_cpu_count());
+
+    for (int threads = 1; threads <= max_threads; threads *= 2) {
+        const SearchLimits limits = {.nodes = playouts, .threads = threads, .quiet = true};
+        uint64_t total = 0, total_ns = 0;
+        for (size_t i = 0; i < count; i++) {
+            const Bitboard board = init_Bitboard(BENCH_POSITIONS[i]);
+            SearchResult result;
+            mcts_clear();
+            mcts_search(&board, NULL, 0, &limits, &result);
+            total += result.nodes;
+            total_ns += result.time_ns;
+        }
+        printf("%3d threads  playouts %10llu  time %7.3f s  playouts/s %9.0f\n", threads, (unsigned long long)total,
+               (double)total_ns / 1e9, total_ns ? (double)total * 1e9 / (double)total_ns : 0.0);
+    }
+
+    // Reuse: search, play the best move and the reply the tree expects, search again.
+    const SearchLimits limits = {.nodes = playouts, .threads = 1, .quiet = true};
+    Bitboard board = init_Bitboard(BENCH_START);
+    SearchResult result;
+    mcts_clear();
+    mcts_search(&board, NULL, 0, &limits, &result);
+    const size_t before = mcts_tree_nodes();
+    Undo undo;
+    make_move(&board, result.pv[0], &undo);
+    if (result.pv_length > 1) make_move(&board, result.pv[1], &undo);
+    const uint64_t start = time_now_ns();
+    const bool kept = mcts_set_root(&board);
+    printf("Subtree reuse after two plies: %zu of %zu nodes kept%s, %.3f ms\n", mcts_tree_nodes(), before,
+           kept ? "" : " (not found)", (double)(time_now_ns() - start) / 1e6);
+}
+
+// --- Batch bench ---
+
+void bench_batch(const size_t count, const int depth, int max_threads) {
+    if (max_threads < 1) max_threads = 1;
+    if (max_threads > BATCH_MAX_THREADS) max_threads = BATCH_MAX_THREADS;
+    Bitboard* positions = malloc(count * sizeof(Bitboard));
+    int* scores = malloc(count * sizeof(int));
+    if (!positions || !scores) {
+        fprintf(stderr, "Failed to allocate benchmark positions\n");
+        exit(EXIT_FAILURE);
+    }
+
+    // Every position along random games from the start position.
+    uint64_t rng = 0xBA7C4;
+    size_t n = 0;
+    while (n < count) {
+        Bitboard board = init_Bitboard(BENCH_START);
+        for (int ply = 0; ply < BENCH_GAME_PLIES && n < count; ply++) {
+            MoveList list;
+            list.count = 0;
+            generate_legal_moves(&board, &list);
+            if (list.count == 0) break;
+            positions[n++] = board;
+            Undo undo;
+            make_move(&board, list.moves[bench_random(&rng) % list.count], &undo);
+        }
+    }
+    printf("%zu positions from random games, %s eval, %d CPUs online\n", count,
+           nnue_enabled() ? "NNUE" : "handcrafted", threadpool_cpu_count());
+
+    for (int threads = 1; threads <= max_threads; threads *= 2) {
+        uint64_t start = time_now_ns();
+        batch_evaluate(positions, NULL, count, scores, threads);
+        const uint64_t eval_ns = time_now_ns() - start;
+        int64_t checksum = 0;
+        for (size_t i = 0; i < count; i++) checksum += scores[i];
+        printf("%3d threads  static eval  %10.0f positions/s  (checksum %lld)\n", threads,
+               eval_ns ? (double)count * 1e9 / (double)eval_ns : 0.0, (long long)checksum);
+
+        if (depth <= 0) continue;
+        tt_clear();
+        start = time_now_ns();
+        batch_search(positions, NULL, count, depth, scores, NULL, threads);
+        const uint64_t search_ns = time_now_ns() - start;
+        printf("%3d threads  depth %-2d     %10.0f positions/s\n", threads, depth,
+               search_ns ? (double)count * 1e9 / (double)search_ns : 0.0);
+    }
+    free(scores);
+    free(positions);
+}
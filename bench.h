@@ -0,0 +1,41 @@
+//
+// Created by lenovo on 10/18/2026.
+//
+
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <stdint.h>
+
+// Slider lookup latency of the magic and PEXT backends against the dense
+// one-entry-per-index magic layout, over occupancies sampled from random games. Each
+// lookup depends on the previous result, so the figures are latencies rather than throughput.
+void bench_attacks(uint64_t lookups);
+
+// Fixed-depth search over a fixed position set, each from a cleared hash table.
+// Prints nodes and time per position and the total nodes/sec. Returns total nodes,
+// which also serves as a signature: any change to the search tree changes it.
+uint64_t bench_search(int depth);
+
+// Lazy SMP time-to-depth: the bench positions searched to `depth` with 1, 2, 4, ...
+// up to `max_threads` threads, each position from a cleared hash table. Prints the
+// total time and the speedup over one thread per thread count. Returns total nodes.
+uint64_t bench_smp(int depth, int max_threads);
+
+// Evaluation cost, handcrafted against NNUE (incremental and from scratch, AVX2 and
+// scalar), over every child of the positions along random games. Loads `network`,
+// or else uses the one already loaded or NNUE_PATH.
+void bench_eval(const char* network, int rounds);
+
+// MCTS playouts/sec over the bench positions for 1, 2, 4, ... max_threads threads,
+// then how much of the tree survives into the next move.
+void bench_mcts(uint64_t playouts, int max_threads);
+
+// Batch static-eval and fixed-depth positions/sec over random-game positions for
+// 1, 2, 4, ... max_threads threads. depth 0 skips the searches.
+void bench_batch(size_t count, int depth, int max_threads);
+
+// SEE latency over the captures of random games.
+void bench_see(uint64_t calls);
+
+#endif //BENCH_H
@@ -4,22 +4,10 @@
 #include <stdbool.h>
 #include <ctype.h>
 #include "constants.h"
+#include "bitboard.h"
 #include "utils.h"
-
-// Bitboard representation
-typedef struct {
-    uint64_t pieces[12]; // 0-5: White (P,N,B,R,Q,K), 6-11: Black (p,n,b,r,q,k)
-    uint64_t white_occupancy;
-    uint64_t black_occupancy;
-    uint64_t all_occupancy;
-	bool to_move;              // 0 = white, 1 = black
-    uint8_t castling_rights;  // KQkq bits
-    uint64_t en_passant_target;  // 0-7 or 8 if none
-	uint8_t en_passant_rank;
-	uint8_t en_passant_file;
-	uint16_t halfmove_clock;
-    uint16_t fullmove_number;
-} Bitboard;
+#include "zobrist.h"
+#include "eval.h"
 
 // Piece mapping helper
 int piece_from_char(char c) {
@@ -64,7 +52,8 @@ int index_from_piece(uint8_t piece) {
 
 
 
-Bitboard init_Bitboard(const char* FEN) {
+// Parses FEN into *out. On a malformed string returns false, printing why if `report`.
+static bool parse_fen(const char* FEN, Bitboard* out, const bool report) {
     Bitboard b = {0};
     uint8_t row = 0, col = 0;
     const char* original_FEN = FEN; // Keep track of original for debugging
@@ -87,9 +76,9 @@ Bitboard init_Bitboard(const char* FEN) {
             // printf("DEBUG: Skipping %d squares, col now = %d\n", skip, col);
         } else {
             if (col < 8) {
-                const uint8_t piece = piece_from_char(c);
+                const int piece = piece_from_char(c);
                 if (piece != PIECE_EMPTY) {
-                    const uint8_t index = index_from_piece(piece);
+                    const int index = index_from_piece((uint8_t)piece);
                     if (index != INDEX_EMPTY) {
                         const uint64_t bit = square_bit(row, col);
                         // printf("DEBUG: Placing piece '%c' (piece=%d, index=%d) at row=%d, col=%d, bit=0x%llx\n" c, piece, index, row, col, bit);
@@ -100,12 +89,12 @@ Bitboard init_Bitboard(const char* FEN) {
                             b.white_occupancy |= bit;
                         b.all_occupancy |= bit;
                     } else {
-                        fprintf(stderr, "Invalid piece index for '%c' at row %d, col %d\n", c, row, col);
-                        exit(EXIT_FAILURE);
+                        if (report) fprintf(stderr, "Invalid piece index for '%c' at row %d, col %d\n", c, row, col);
+                        return false;
                     }
                 } else {
-                    fprintf(stderr, "Invalid piece '%c' at row %d, col %d\n", c, row, col);
-                    exit(EXIT_FAILURE);
+                    if (report) fprintf(stderr, "Invalid piece '%c' at row %d, col %d\n", c, row, col);
+                    return false;
                 }
                 col++;
                 // printf("DEBUG: After placing piece, col=%d\n", col);
@@ -117,6 +106,11 @@ Bitboard init_Bitboard(const char* FEN) {
         }
     }
 
+    if (row != 7 || col != 8) {
+        if (report) fprintf(stderr, "Incomplete piece placement in FEN: '%s'\n", original_FEN);
+        return false;
+    }
+
     // printf("DEBUG: Finished piece placement. Current FEN position: '%s'\n", FEN);
     // printf("DEBUG: Next char is '%c' (ASCII: %d)\n", *FEN ? *FEN : '?', *FEN);
 
@@ -135,10 +129,12 @@ Bitboard init_Bitboard(const char* FEN) {
         b.to_move = 1;
         // printf("DEBUG: Side to move: Black\n");
     } else {
-        fprintf(stderr, "Invalid side to move in FEN: '%c' (ASCII: %d)\n", *FEN, (int)*FEN);
-        fprintf(stderr, "Original FEN: '%s'\n", original_FEN);
-        fprintf(stderr, "Current position in FEN: '%s'\n", FEN);
-        exit(EXIT_FAILURE);
+        if (report) {
+            fprintf(stderr, "Invalid side to move in FEN: '%c' (ASCII: %d)\n", *FEN, (int)*FEN);
+            fprintf(stderr, "Original FEN: '%s'\n", original_FEN);
+            fprintf(stderr, "Current position in FEN: '%s'\n", FEN);
+        }
+        return false;
     }
     FEN++; // move past 'w' or 'b'
 
@@ -159,20 +155,75 @@ Bitboard init_Bitboard(const char* FEN) {
                 case 'k': b.castling_rights |= CASTLE_BLACK_K; break;
                 case 'q': b.castling_rights |= CASTLE_BLACK_Q; break;
                 default:
-                    fprintf(stderr, "Invalid castling character: %c\n", *FEN);
-                    exit(EXIT_FAILURE);
+                    if (report) fprintf(stderr, "Invalid castling character: %c\n", *FEN);
+                    return false;
             }
             FEN++;
         }
     }
 
-    // For now, just set defaults for the remaining fields
+    // Skip whitespace before en passant target
+    while (*FEN && *FEN == ' ') {
+        FEN++;
+    }
+
+    // Parse en passant target
     b.en_passant_target = 0;
     b.en_passant_file = 0xFF;
     b.en_passant_rank = 0xFF;
+    if (*FEN == '-') {
+        FEN++;
+    } else if (*FEN >= 'a' && *FEN <= 'h' && FEN[1] >= '1' && FEN[1] <= '8') {
+        b.en_passant_file = FEN[0] - 'a';
+        b.en_passant_rank = FEN[1] - '1';
+        b.en_passant_target = 1ULL << (b.en_passant_rank * 8 + b.en_passant_file);
+        FEN += 2;
+        // Like make_move, keep the target only if a pawn of the side to move can capture
+        // there, so the key matches the same position reached by moves.
+        const uint64_t capturers = generate_pawn_attack_mask(b.en_passant_target, b.to_move == BLACK);
+        if (!(capturers & b.pieces[INDEX_OF(b.to_move, INDEX_PAWN)])) {
+            b.en_passant_target = 0;
+            b.en_passant_file = 0xFF;
+            b.en_passant_rank = 0xFF;
+        }
+    } else if (*FEN) {
+        if (report) fprintf(stderr, "Invalid en passant square in FEN: '%s'\n", FEN);
+        return false;
+    }
+
+    // Halfmove clock and fullmove number are optional
     b.halfmove_clock = 0;
     b.fullmove_number = 1;
+    char* end;
+    long value = strtol(FEN, &end, 10);
+    if (end != FEN) {
+        b.halfmove_clock = (uint16_t)value;
+        FEN = end;
+        value = strtol(FEN, &end, 10);
+        if (end != FEN && value > 0) b.fullmove_number = (uint16_t)value;
+    }
+
+    b.key = compute_key(&b);
+    b.pawn_key = compute_pawn_key(&b);
+    b.material_key = compute_material_key(&b);
+
+    int mg, eg, phase;
+    compute_psq(&b, &mg, &eg, &phase);
+    b.psq_mg = (int16_t)mg;
+    b.psq_eg = (int16_t)eg;
+    b.phase = (uint8_t)phase;
 
+    *out = b;
+    return true;
+}
+
+bool try_init_Bitboard(const char* FEN, Bitboard* out) {
+    return parse_fen(FEN, out, false);
+}
+
+Bitboard init_Bitboard(const char* FEN) {
+    Bitboard b;
+    if (!parse_fen(FEN, &b, true)) exit(EXIT_FAILURE);
     return b;
 }
 
@@ -209,6 +260,7 @@ void print_board(const Bitboard board) {
     printf("En passant target: 0x%llx\n", board.en_passant_target);
     printf("Halfmove clock: %u\n", board.halfmove_clock);
     printf("Fullmove number: %u\n", board.fullmove_number);
+    printf("Key: 0x%016llx\n", (unsigned long long)board.key);
 }
 
 // bool is_king_check(Bitboard board) {
@@ -241,74 +293,6 @@ void print_board(const Bitboard board) {
 //     return false;
 // }
 
-static inline uint32_t count_trailing_zeros(uint64_t x) {
-#if defined(_MSC_VER)
-    unsigned long index;
-    _BitScanForward64(&index, x);
-    return index;
-#elif defined(__GNUC__) || defined(__clang__)
-    return count_trailing_zeros(x);
-#else
-    // fallback (not efficient)
-    uint32_t count = 0;
-    while ((x & 1) == 0 && count < 64) {
-        x >>= 1;
-        count++;
-    }
-    return count;
-#endif
-}
-
-
-// Common file masks
-const uint64_t NOT_FILE_A  = ~MASK_FILE_A;
-const uint64_t NOT_FILE_B  = ~MASK_FILE_B;
-const uint64_t NOT_FILE_G  = ~MASK_FILE_G;
-const uint64_t NOT_FILE_H  = ~MASK_FILE_H;
-const uint64_t NOT_FILE_AB = ~(MASK_FILE_A | MASK_FILE_B);
-const uint64_t NOT_FILE_GH = ~(MASK_FILE_H | MASK_FILE_G);
-
-static inline uint64_t generate_pawn_attack_mask(uint64_t pawns, bool white) {
-    if (white) {
-        pawns &= ~MASK_RANK_8;
-        return ((pawns & NOT_FILE_A) << 7) | ((pawns & NOT_FILE_H) << 9);
-    } else {
-        pawns &= ~MASK_RANK_1;
-        return ((pawns & NOT_FILE_A) >> 9) | ((pawns & NOT_FILE_H) >> 7);
-    }
-}
-
-
-static inline uint64_t generate_knight_attack_mask(uint64_t knights) {
-    uint64_t attacks = 0ULL;
-    attacks |= (knights & NOT_FILE_H)  << 17;
-    attacks |= (knights & NOT_FILE_GH) << 10;
-    attacks |= (knights & NOT_FILE_GH) >> 6;
-    attacks |= (knights & NOT_FILE_H)  >> 15;
-
-    attacks |= (knights & NOT_FILE_A)  << 15;
-    attacks |= (knights & NOT_FILE_AB) << 6;
-    attacks |= (knights & NOT_FILE_AB) >> 10;
-    attacks |= (knights & NOT_FILE_A)  >> 17;
-
-    return attacks;
-}
-
-static inline uint64_t generate_king_attack_mask(uint64_t king) {
-    uint64_t attacks = 0ULL;
-
-    attacks |= king << 8;  // N
-    attacks |= king >> 8;  // S
-    attacks |= (king & NOT_FILE_H) << 1;  // E
-    attacks |= (king & NOT_FILE_A) >> 1;  // W
-    attacks |= (king & NOT_FILE_H) << 9;  // NE
-    attacks |= (king & NOT_FILE_A) << 7;  // NW
-    attacks |= (king & NOT_FILE_H) >> 7;  // SE
-    attacks |= (king & NOT_FILE_A) >> 9;  // SW
-
-    return attacks;
-}
-
 uint64_t generate_white_pawn_attack_mask(Bitboard board) {
     return generate_pawn_attack_mask(board.pieces[INDEX_WPAWN], true);
 }
@@ -334,33 +318,22 @@ uint64_t generate_black_king_attack_mask(Bitboard board) {
 }
 
 static inline uint64_t generate_pawn_attack_mask_from_board(Bitboard board, bool side) {
-    const uint64_t pawns = side ? board.pieces[INDEX_WPAWN] : board.pieces[INDEX_BPAWN];
-    return generate_pawn_attack_mask(pawns, side);
+    const uint64_t pawns = side == WHITE ? board.pieces[INDEX_WPAWN] : board.pieces[INDEX_BPAWN];
+    return generate_pawn_attack_mask(pawns, side == WHITE);
 }
 
 static inline uint64_t generate_knight_attack_mask_from_board(Bitboard board, bool side) {
-    const uint64_t knights = side ? board.pieces[INDEX_WKNIGHT] : board.pieces[INDEX_BKNIGHT];
+    const uint64_t knights = side == WHITE ? board.pieces[INDEX_WKNIGHT] : board.pieces[INDEX_BKNIGHT];
     return generate_knight_attack_mask(knights);
 }
 
 static inline uint64_t generate_king_attack_mask_from_board(Bitboard board, bool side) {
-    const uint64_t king = side ? board.pieces[INDEX_WKING] : board.pieces[INDEX_BKING];
+    const uint64_t king = side == WHITE ? board.pieces[INDEX_WKING] : board.pieces[INDEX_BKING];
     return generate_king_attack_mask(king);
 }
 
-static inline uint64_t generate_pawn_movement(uint64_t pawns,uint64_t empty, bool side) {
-    if (side == WHITE) {
-        const uint64_t singlePush = (pawns << 8) & empty;
-        const uint64_t doublePush = ((singlePush & MASK_RANK_3) << 8) & empty;
-        return singlePush | doublePush;
-    }
-    const uint64_t singlePush = (pawns >> 8) & empty;
-    const uint64_t doublePush = ((singlePush & MASK_RANK_6) >> 8) & empty;
-    return singlePush | doublePush;
-}
-
 static inline uint64_t generate_pawn_movement_mask_from_board(Bitboard board, bool side) {
-    const uint64_t pawns = side ? board.pieces[INDEX_WPAWN] : board.pieces[INDEX_BPAWN];
+    const uint64_t pawns = side == WHITE ? board.pieces[INDEX_WPAWN] : board.pieces[INDEX_BPAWN];
     const uint64_t empty = ~board.all_occupancy;
     return generate_pawn_movement(pawns, empty, side);
 }
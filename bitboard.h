@@ -7,6 +7,7 @@
 
 #include <stdint.h>  // for uint64_t, uint8_t
 #include <stdbool.h>
+#include "constants.h"
 
 typedef struct {
     uint64_t pieces[12];        // 0-5: White (P,N,B,R,Q,K), 6-11: Black (p,n,b,r,q,k)
@@ -20,12 +21,92 @@ typedef struct {
     uint8_t en_passant_file;
     uint16_t halfmove_clock;
     uint16_t fullmove_number;
+    uint64_t key;               // Zobrist key of the whole position
+    uint64_t pawn_key;          // pawns only
+    uint64_t material_key;      // piece counts only
+    int16_t psq_mg;             // material + piece-square sums from White's view, see eval.h
+    int16_t psq_eg;
+    uint8_t phase;              // sum of PHASE_WEIGHTS over the pieces on the board
+    struct NnueAccumulator* nnue;   // current entry of the search's accumulator stack, NULL when unused
 } Bitboard;
 
+// Common file masks
+#define NOT_FILE_A   (~MASK_FILE_A)
+#define NOT_FILE_B   (~MASK_FILE_B)
+#define NOT_FILE_G   (~MASK_FILE_G)
+#define NOT_FILE_H   (~MASK_FILE_H)
+#define NOT_FILE_AB  (~(MASK_FILE_A | MASK_FILE_B))
+#define NOT_FILE_GH  (~(MASK_FILE_H | MASK_FILE_G))
+
 // === Function declarations ===
 int piece_from_char(char c);
 int index_from_piece(uint8_t piece);
 Bitboard init_Bitboard(const char* FEN);
+// Same without exiting: false on a malformed FEN. The position may still be illegal,
+// see position_is_legal.
+bool try_init_Bitboard(const char* FEN, Bitboard* out);
 void print_board(Bitboard board);
 
+// Index (0-11) of the piece on `sq`, INDEX_EMPTY if the square is empty.
+static inline int piece_on(const Bitboard* b, int sq) {
+    const uint64_t bit = 1ULL << sq;
+    if (!(b->all_occupancy & bit)) return INDEX_EMPTY;
+    const int first = (b->black_occupancy & bit) ? INDEX_BPAWN : INDEX_WPAWN;
+    for (int i = first; i < first + 6; i++) {
+        if (b->pieces[i] & bit) return i;
+    }
+    return INDEX_EMPTY;
+}
+
+static inline uint64_t generate_pawn_attack_mask(uint64_t pawns, bool white) {
+    if (white) {
+        pawns &= ~MASK_RANK_8;
+        return ((pawns & NOT_FILE_A) << 7) | ((pawns & NOT_FILE_H) << 9);
+    } else {
+        pawns &= ~MASK_RANK_1;
+        return ((pawns & NOT_FILE_A) >> 9) | ((pawns & NOT_FILE_H) >> 7);
+    }
+}
+
+static inline uint64_t generate_knight_attack_mask(uint64_t knights) {
+    uint64_t attacks = 0ULL;
+    attacks |= (knights & NOT_FILE_H)  << 17;
+    attacks |= (knights & NOT_FILE_GH) << 10;
+    attacks |= (knights & NOT_FILE_GH) >> 6;
+    attacks |= (knights & NOT_FILE_H)  >> 15;
+
+    attacks |= (knights & NOT_FILE_A)  << 15;
+    attacks |= (knights & NOT_FILE_AB) << 6;
+    attacks |= (knights & NOT_FILE_AB) >> 10;
+    attacks |= (knights & NOT_FILE_A)  >> 17;
+
+    return attacks;
+}
+
+static inline uint64_t generate_king_attack_mask(uint64_t king) {
+    uint64_t attacks = 0ULL;
+
+    attacks |= king << 8;  // N
+    attacks |= king >> 8;  // S
+    attacks |= (king & NOT_FILE_H) << 1;  // E
+    attacks |= (king & NOT_FILE_A) >> 1;  // W
+    attacks |= (king & NOT_FILE_H) << 9;  // NE
+    attacks |= (king & NOT_FILE_A) << 7;  // NW
+    attacks |= (king & NOT_FILE_H) >> 7;  // SE
+    attacks |= (king & NOT_FILE_A) >> 9;  // SW
+
+    return attacks;
+}
+
+static inline uint64_t generate_pawn_movement(uint64_t pawns,uint64_t empty, bool side) {
+    if (side == WHITE) {
+        const uint64_t singlePush = (pawns << 8) & empty;
+        const uint64_t doublePush = ((singlePush & MASK_RANK_3) << 8) & empty;
+        return singlePush | doublePush;
+    }
+    const uint64_t singlePush = (pawns >> 8) & empty;
+    const uint64_t doublePush = ((singlePush & MASK_RANK_6) >> 8) & empty;
+    return singlePush | doublePush;
+}
+
 #endif //BITBOARD_H
@@ -2,8 +2,11 @@
 // Created by lenovo on 7/30/2025.
 //
 
-#ifndef BITBOARD_H
-#define BITBOARD_H
+#ifndef CONSTANTS_H
+#define CONSTANTS_H
+
+#include <stdint.h>
+#include <stdbool.h>
 
 // === Chess Piece values (bitboard index) ===
 #define PIECE_PAWN     0
@@ -51,6 +54,10 @@
 #define PIECE_EMPTY     -1  // Not used in bitboards but may help in logic
 #define INDEX_EMPTY     -1
 
+#define INDEX_OF(side, type)  ((side) * 6 + (type))      // side: WHITE (0) / BLACK (1)
+#define INDEX_TYPE(index)     ((index) >= 6 ? (index) - 6 : (index))
+#define INDEX_SIDE(index)     ((index) >= 6)
+
 // === castling ===
 
 #define CASTLE_WHITE_K 0x1
@@ -64,10 +71,6 @@
 
 // === Move generation ===
 #define MAX_MOVES              256
-#define MOVE_FLAG_CAPTURE      0x01
-#define MOVE_FLAG_PROMOTION    0x02
-#define MOVE_FLAG_ENPASSANT    0x04
-#define MOVE_FLAG_CASTLE       0x08
 
 #define MASK_FILE_A  0x0101010101010101ULL  // File a: bits   0,  8, 16, ..., 56
 #define MASK_FILE_B  0x0202020202020202ULL  // File b: bits   1,  9, 17, ..., 57
@@ -120,5 +123,5 @@ static const uint64_t RANK_MASKS[8] = {
 #define BLACK true
 #endif
 
-#endif // BITBOARD_H
+#endif // CONSTANTS_H
 
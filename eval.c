@@ -0,0 +1,213 @@
+//
+// Created by lenovo on 10/18/2026.
+//
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include "constants.h"
+#include "bitboard.h"
+#include "eval.h"
+#include "nnue.h"
+#include "utils.h"
+
+const int PIECE_VALUES[6] = {
+    [INDEX_PAWN] = 100,
+    [INDEX_KNIGHT] = 320,
+    [INDEX_BISHOP] = 330,
+    [INDEX_ROOK] = 500,
+    [INDEX_QUEEN] = 900,
+    [INDEX_KING] = 0,
+};
+
+const int PHASE_WEIGHTS[6] = {
+    [INDEX_PAWN] = 0,
+    [INDEX_KNIGHT] = 1,
+    [INDEX_BISHOP] = 1,
+    [INDEX_ROOK] = 2,
+    [INDEX_QUEEN] = 4,
+    [INDEX_KING] = 0,
+};
+
+int16_t PSQ_MG[12][64];
+int16_t PSQ_EG[12][64];
+
+static const int MG_VALUES[6] = {82, 337, 365, 477, 1025, 0};
+static const int EG_VALUES[6] = {94, 281, 297, 512, 936, 0};
+
+// Piece-square bonuses for White, laid out as the board is printed: a8 first, h1 last.
+// Only pawns and the king play differently in the endgame.
+static const int8_t PAWN_MG[64] = {
+      0,   0,   0,   0,   0,   0,   0,   0,
+     50,  50,  50,  50,  50,  50,  50,  50,
+     10,  10,  20,  30,  30,  20,  10,  10,
+      5,   5,  10,  25,  25,  10,   5,   5,
+      0,   0,   0,  20,  20,   0,   0,   0,
+      5,  -5, -10,   0,   0, -10,  -5,   5,
+      5,  10,  10, -20, -20,  10,  10,   5,
+      0,   0,   0,   0,   0,   0,   0,   0,
+};
+
+static const int8_t PAWN_EG[64] = {
+      0,   0,   0,   0,   0,   0,   0,   0,
+     80,  80,  80,  80,  80,  80,  80,  80,
+     50,  50,  50,  50,  50,  50,  50,  50,
+     30,  30,  30,  30,  30,  30,  30,  30,
+     15,  15,  15,  15,  15,  15,  15,  15,
+      5,   5,   5,   5,   5,   5,   5,   5,
+      0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,
+};
+
+static const int8_t KNIGHT_PSQ[64] = {
+    -50, -40, -30, -30, -30, -30, -40, -50,
+    -40, -20,   0,   0,   0,   0, -20, -40,
+    -30,   0,  10,  15,  15,  10,   0, -30,
+    -30,   5,  15,  20,  20,  15,   5, -30,
+    -30,   0,  15,  20,  20,  15,   0, -30,
+    -30,   5,  10,  15,  15,  10,   5, -30,
+    -40, -20,   0,   5,   5,   0, -20, -40,
+    -50, -40, -30, -30, -30, -30, -40, -50,
+};
+
+static const int8_t BISHOP_PSQ[64] = {
+    -20, -10, -10, -10, -10, -10, -10, -20,
+    -10,   0,   0,   0,   0,   0,   0, -10,
+    -10,   0,   5,  10,  10,   5,   0, -10,
+    -10,   5,   5,  10,  10,   5,   5, -10,
+    -10,   0,  10,  10,  10,  10,   0, -10,
+    -10,  10,  10,  10,  10,  10,  10, -10,
+    -10,   5,   0,   0,   0,   0,   5, -10,
+    -20, -10, -10, -10, -10, -10, -10, -20,
+};
+
+static const int8_t ROOK_PSQ[64] = {
+      0,   0,   0,   0,   0,   0,   0,   0,
+      5,  10,  10,  10,  10,  10,  10,   5,
+     -5,   0,   0,   0,   0,   0,   0,  -5,
+     -5,   0,   0,   0,   0,   0,   0,  -5,
+     -5,   0,   0,   0,   0,   0,   0,  -5,
+     -5,   0,   0,   0,   0,   0,   0,  -5,
+     -5,   0,   0,   0,   0,   0,   0,  -5,
+      0,   0,   0,   5,   5,   0,   0,   0,
+};
+
+static const int8_t QUEEN_PSQ[64] = {
+    -20, -10, -10,  -5,  -5, -10, -10, -20,
+    -10,   0,   0,   0,   0,   0,   0, -10,
+    -10,   0,   5,   5,   5,   5,   0, -10,
+     -5,   0,   5,   5,   5,   5,   0,  -5,
+      0,   0,   5,   5,   5,   5,   0,  -5,
+    -10,   5,   5,   5,   5,   5,   0, -10,
+    -10,   0,   5,   0,   0,   0,   0, -10,
+    -20, -10, -10,  -5,  -5, -10, -10, -20,
+};
+
+static const int8_t KING_MG[64] = {
+    -30, -40, -40, -50, -50, -40, -40, -30,
+    -30, -40, -40, -50, -50, -40, -40, -30,
+    -30, -40, -40, -50, -50, -40, -40, -30,
+    -30, -40, -40, -50, -50, -40, -40, -30,
+    -20, -30, -30, -40, -40, -30, -30, -20,
+    -10, -20, -20, -20, -20, -20, -20, -10,
+     20,  20,   0,   0,   0,   0,  20,  20,
+     20,  30,  10,   0,   0,  10,  30,  20,
+};
+
+static const int8_t KING_EG[64] = {
+    -50, -40, -30, -20, -20, -30, -40, -50,
+    -30, -20, -10,   0,   0, -10, -20, -30,
+    -30, -10,  20,  30,  30,  20, -10, -30,
+    -30, -10,  30,  40,  40,  30, -10, -30,
+    -30, -10,  30,  40,  40,  30, -10, -30,
+    -30, -10,  20,  30,  30,  20, -10, -30,
+    -30, -30,   0,   0,   0,   0, -30, -30,
+    -50, -30, -30, -30, -30, -30, -30, -50,
+};
+
+static const int8_t* const PSQ_TABLES_MG[6] = {PAWN_MG, KNIGHT_PSQ, BISHOP_PSQ, ROOK_PSQ, QUEEN_PSQ, KING_MG};
+static const int8_t* const PSQ_TABLES_EG[6] = {PAWN_EG, KNIGHT_PSQ, BISHOP_PSQ, ROOK_PSQ, QUEEN_PSQ, KING_EG};
+
+void init_eval(void) {
+    for (int type = INDEX_PAWN; type <= INDEX_KING; type++) {
+        for (int sq = 0; sq < 64; sq++) {
+            // The tables start at a8: White's square sq is entry sq ^ 56, and Black
+            // sees the board mirrored, so its square sq is entry sq.
+            const int white = INDEX_OF(WHITE, type), black = INDEX_OF(BLACK, type);
+            PSQ_MG[white][sq] = (int16_t)(MG_VALUES[type] + PSQ_TABLES_MG[type][sq ^ 56]);
+            PSQ_EG[white][sq] = (int16_t)(EG_VALUES[type] + PSQ_TABLES_EG[type][sq ^ 56]);
+            PSQ_MG[black][sq] = (int16_t)-(MG_VALUES[type] + PSQ_TABLES_MG[type][sq]);
+            PSQ_EG[black][sq] = (int16_t)-(EG_VALUES[type] + PSQ_TABLES_EG[type][sq]);
+        }
+    }
+}
+
+void compute_psq(const Bitboard* b, int* mg, int* eg, int* phase) {
+    *mg = *eg = *phase = 0;
+    for (int i = 0; i < 12; i++) {
+        uint64_t pieces = b->pieces[i];
+        *phase += PHASE_WEIGHTS[INDEX_TYPE(i)] * popcount(pieces);
+        while (pieces) {
+            const int sq = pop_lsb(&pieces);
+            *mg += PSQ_MG[i][sq];
+            *eg += PSQ_EG[i][sq];
+        }
+    }
+}
+
+void verify_eval(const Bitboard* b, const char* where) {
+    int mg, eg, phase;
+    compute_psq(b, &mg, &eg, &phase);
+    if (b->psq_mg == mg && b->psq_eg == eg && b->phase == phase) return;
+    fprintf(stderr, "Incremental eval mismatch after %s: mg %d/%d eg %d/%d phase %d/%d\n", where, b->psq_mg, mg,
+            b->psq_eg, eg, b->phase, phase);
+    print_board(*b);
+    abort();
+}
+
+bool eval_cache_resize(EvalCache* cache, const size_t kb) {
+    free(cache->entries);
+    cache->entries = NULL;
+    cache->mask = 0;
+    cache->kb = kb;
+    size_t count = kb * 1024 / sizeof(uint64_t);
+    if (count == 0) return true;
+    while (count & (count - 1)) count &= count - 1;
+
+    cache->entries = calloc(count, sizeof(uint64_t));
+    if (!cache->entries) return false;
+    cache->mask = count - 1;
+    return true;
+}
+
+static int evaluate_uncached(const Bitboard* b, EvalState* state) {
+    if (b->nnue) return nnue_evaluate(b);
+
+    PawnEntry local;
+    PawnEntry* pawns = &local;
+    if (state && state->pawns) {
+        pawns = pawn_probe(state->pawns, b);
+    } else {
+        pawn_evaluate(b, &local);
+    }
+    const int mg = b->psq_mg + pawns->mg + pawn_shelter(pawns, b, WHITE) - pawn_shelter(pawns, b, BLACK);
+    const int eg = b->psq_eg + pawns->eg + passed_free_path(pawns, b);
+
+    const int phase = b->phase < PHASE_MAX ? b->phase : PHASE_MAX;
+    const int score = (mg * phase + eg * (PHASE_MAX - phase)) / PHASE_MAX;
+    return b->to_move == WHITE ? score : -score;
+}
+
+int evaluate_position(const Bitboard* b, EvalState* state) {
+    EvalCache* cache = state ? state->cache : NULL;
+    if (!cache || !cache->entries) return evaluate_uncached(b, state);
+
+    uint64_t* slot = &cache->entries[b->key & cache->mask];
+    cache->probes++;
+    if (((*slot ^ b->key) & ~0xFFFFULL) == 0) {
+        cache->hits++;
+        return (int16_t)(*slot & 0xFFFF);
+    }
+    const int score = evaluate_uncached(b, state);
+    *slot = (b->key & ~0xFFFFULL) | (uint16_t)score;
+    return score;
+}
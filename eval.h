@@ -0,0 +1,70 @@
+//
+// Created by lenovo on 10/18/2026.
+//
+
+#ifndef EVAL_H
+#define EVAL_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "bitboard.h"
+#include "pawns.h"
+
+// Piece values in centipawns, by INDEX_TYPE. Used for move ordering and exchanges;
+// the evaluation itself uses the phase-dependent values folded into PSQ_MG/PSQ_EG.
+extern const int PIECE_VALUES[6];
+
+// Game phase: the sum of PHASE_WEIGHTS over the pieces on the board, PHASE_MAX
+// with all minor and major pieces present (more only after promotions), 0 with
+// pawns and kings alone.
+#define PHASE_MAX 24
+extern const int PHASE_WEIGHTS[6];
+
+// Material plus piece-square bonus of piece `index` (0-11) on `sq`, midgame and
+// endgame, from White's point of view (Black pieces are negative). Bitboard keeps
+// the sums in psq_mg/psq_eg, updated by make_move/unmake_move.
+extern int16_t PSQ_MG[12][64];
+extern int16_t PSQ_EG[12][64];
+
+// Fills PSQ_MG/PSQ_EG. Call once at startup, before the first init_Bitboard.
+void init_eval(void);
+
+// From-scratch sums, for initialisation and cross-checks.
+void compute_psq(const Bitboard* b, int* mg, int* eg, int* phase);
+
+// Aborts with a diagnostic if the incremental psq_mg/psq_eg/phase differ from a recompute.
+void verify_eval(const Bitboard* b, const char* where);
+
+// Lossy cache of final static scores by position key, one per search thread.
+// Each slot is one word, (key & ~0xFFFF) | (uint16_t)score, so a lookup is a
+// single load and a colliding store simply overwrites.
+typedef struct {
+    uint64_t* entries;          // NULL: disabled
+    size_t mask;                // entries - 1
+    size_t kb;                  // size as requested
+    uint64_t probes;
+    uint64_t hits;
+} EvalCache;
+
+#define EVAL_CACHE_DEFAULT_KB 256
+
+// Reallocates `cache` with the largest power-of-two entry count that fits in
+// `kb` kilobytes, empty; 0 frees it. Returns false, leaving it disabled, if the
+// allocation fails.
+bool eval_cache_resize(EvalCache* cache, size_t kb);
+
+// Per-thread caches behind evaluate_position, owned by a SearchThread. A NULL
+// state, or a NULL member, evaluates without that cache.
+typedef struct {
+    PawnTable* pawns;
+    EvalCache* cache;
+} EvalState;
+
+// Static evaluation in centipawns from the side to move's point of view: material,
+// piece-square and pawn-structure terms, midgame and endgame blended by phase; or
+// the network's output when the board is attached to an NNUE accumulator stack
+// (see nnue.h). Looked up in, and stored to, state->cache first.
+int evaluate_position(const Bitboard* b, EvalState* state);
+
+#endif //EVAL_H
@@ -0,0 +1,130 @@
+//
+// Created by lenovo on 10/18/2026.
+//
+// Writes the attack tables out in one of two forms:
+//   generate_attack_tables [path]             binary table file the engine maps at startup
+//   generate_attack_tables --source <path>    C source with every table as a const array,
+//                                             compiled into chess when CHESS_EMBED_TABLES is on
+//
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "attacks.h"
+
+static uint64_t attacks[SLIDER_ATTACK_COUNT];
+static uint8_t slider_index[SLIDER_INDEX_LIMIT];
+static uint8_t pext_index[PEXT_INDEX_SIZE];
+
+static int write_binary(const char* path) {
+    AttackTableHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.tag, ATTACK_TABLE_TAG, sizeof(header.tag));
+    header.version = ATTACK_TABLE_VERSION;
+    header.endian = ATTACK_TABLE_ENDIAN;
+    header.header_size = sizeof(AttackTableHeader);
+    header.attacks_offset = (sizeof(AttackTableHeader) + 63) & ~63U;
+    header.attack_count = SLIDER_ATTACK_COUNT;
+    header.index_offset = header.attacks_offset + SLIDER_ATTACK_COUNT * sizeof(uint64_t);
+    header.index_count = build_slider_tables(header.rook, header.bishop, slider_index, pext_index, attacks);
+    header.pext_offset = (header.index_offset + header.index_count + 63) & ~63U;
+    header.checksum = attack_table_checksum(&header, attacks, slider_index, pext_index);
+
+    FILE* f = fopen(path, "wb");
+    if (!f) {
+        perror("Failed to open output file");
+        return 1;
+    }
+
+    static const char padding[64];
+    const size_t pad = header.attacks_offset - sizeof(header);
+    const size_t pext_pad = header.pext_offset - header.index_offset - header.index_count;
+    if (fwrite(&header, sizeof(header), 1, f) != 1 ||
+        fwrite(padding, 1, pad, f) != pad ||
+        fwrite(attacks, sizeof(uint64_t), SLIDER_ATTACK_COUNT, f) != SLIDER_ATTACK_COUNT ||
+        fwrite(slider_index, 1, header.index_count, f) != header.index_count ||
+        fwrite(padding, 1, pext_pad, f) != pext_pad ||
+        fwrite(pext_index, 1, PEXT_INDEX_SIZE, f) != PEXT_INDEX_SIZE) {
+        perror("Failed to write attack tables");
+        fclose(f);
+        return 1;
+    }
+    fclose(f);
+
+    printf("Wrote %s: version %u, %u attack sets, %u index bytes, checksum %016llx\n", path, header.version,
+           header.attack_count, header.index_count, (unsigned long long)header.checksum);
+    return 0;
+}
+
+static void write_words(FILE* f, const uint64_t* words, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        fprintf(f, "%s0x%016llxULL,", i % 4 == 0 ? "\n    " : " ", (unsigned long long)words[i]);
+    }
+    fprintf(f, "\n");
+}
+
+static void write_array(FILE* f, const char* declaration, const uint64_t* words, size_t count) {
+    fprintf(f, "\n%s = {", declaration);
+    write_words(f, words, count);
+    fprintf(f, "};\n");
+}
+
+static void write_magics(FILE* f, const char* name, const Magic* magics) {
+    fprintf(f, "\nconst Magic %s[64] = {\n", name);
+    for (int sq = 0; sq < 64; sq++) {
+        fprintf(f, "    {0x%016llxULL, 0x%016llxULL, %u, %u, %u, %u},\n", (unsigned long long)magics[sq].mask,
+                (unsigned long long)magics[sq].magic, magics[sq].offset, magics[sq].attacks, magics[sq].shift,
+                magics[sq].pext_offset);
+    }
+    fprintf(f, "};\n");
+}
+
+static void write_bytes(FILE* f, const char* declaration, const uint8_t* bytes, size_t count) {
+    fprintf(f, "\n%s = {", declaration);
+    for (size_t i = 0; i < count; i++) {
+        fprintf(f, "%s%u,", i % 16 == 0 ? "\n    " : " ", bytes[i]);
+    }
+    fprintf(f, "\n};\n");
+}
+
+static int write_source(const char* path) {
+    const uint32_t index_count = build_attack_tables();
+
+    FILE* f = fopen(path, "w");
+    if (!f) {
+        perror("Failed to open output file");
+        return 1;
+    }
+
+    fprintf(f, "// Generated by generate_attack_tables --source. Do not edit.\n");
+    fprintf(f, "#include <stdint.h>\n#include \"attacks.h\"\n\n");
+    fprintf(f, "#ifndef CHESS_EMBED_TABLES\n#error \"attack_tables.c requires CHESS_EMBED_TABLES\"\n#endif\n");
+
+    write_magics(f, "ROOK_MAGICS", ROOK_MAGICS);
+    write_magics(f, "BISHOP_MAGICS", BISHOP_MAGICS);
+    write_array(f, "const uint64_t KNIGHT_ATTACKS[64]", KNIGHT_ATTACKS, 64);
+    write_array(f, "const uint64_t KING_ATTACKS[64]", KING_ATTACKS, 64);
+    write_array(f, "const uint64_t PAWN_ATTACKS[2][64]", &PAWN_ATTACKS[0][0], 2 * 64);
+    write_array(f, "const uint64_t BETWEEN[64][64]", &BETWEEN[0][0], 64 * 64);
+    write_array(f, "const uint64_t LINE[64][64]", &LINE[0][0], 64 * 64);
+    write_array(f, "_Alignas(64) const uint64_t SLIDER_ATTACKS[SLIDER_ATTACK_COUNT]", SLIDER_ATTACKS, SLIDER_ATTACK_COUNT);
+    write_bytes(f, "_Alignas(64) const uint8_t SLIDER_INDEX[]", SLIDER_INDEX, index_count);
+    write_bytes(f, "_Alignas(64) const uint8_t PEXT_INDEX[PEXT_INDEX_SIZE]", PEXT_INDEX, PEXT_INDEX_SIZE);
+
+    if (fclose(f) != 0) {
+        perror("Failed to write attack tables");
+        return 1;
+    }
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc > 1 && strcmp(argv[1], "--source") == 0) {
+        if (argc < 3) {
+            fprintf(stderr, "Usage: %s --source <path>\n", argv[0]);
+            return 1;
+        }
+        return write_source(argv[2]);
+    }
+    return write_binary(argc > 1 ? argv[1] : ATTACK_TABLE_PATH);
+}
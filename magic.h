@@ -1,396 +1,401 @@
 //
-// Created by lenovo on 8/4/2025.
+// Generated by magic_number_generator --seed 1. Do not edit.
 //
 
 #ifndef MAGIC_H
 #define MAGIC_H
 
-#define MAGIC_ROOK_NUM_0 0x80005221804000ULL
+#include <stdint.h>
+
+// MAGIC_*_SHIFT_n is the number of index bits for square n: index = (occ * magic) >> (64 - bits).
+
+// ======= ROOKS =========
+
+#define MAGIC_ROOK_NUM_0 0x9080008010400022ULL
 #define MAGIC_ROOK_SHIFT_0 12
 
-#define MAGIC_ROOK_NUM_1 0xc0004220001000ULL
+#define MAGIC_ROOK_NUM_1 0x1040400010002000ULL
 #define MAGIC_ROOK_SHIFT_1 11
 
-#define MAGIC_ROOK_NUM_2 0x1000c1060004100ULL
+#define MAGIC_ROOK_NUM_2 0x880088020041000ULL
 #define MAGIC_ROOK_SHIFT_2 11
 
-#define MAGIC_ROOK_NUM_3 0x880100004800800ULL
+#define MAGIC_ROOK_NUM_3 0x100082010000500ULL
 #define MAGIC_ROOK_SHIFT_3 11
 
-#define MAGIC_ROOK_NUM_4 0x100021008001500ULL
+#define MAGIC_ROOK_NUM_4 0x4300080010420500ULL
 #define MAGIC_ROOK_SHIFT_4 11
 
-#define MAGIC_ROOK_NUM_5 0x200104108040200ULL
+#define MAGIC_ROOK_NUM_5 0x100020100080400ULL
 #define MAGIC_ROOK_SHIFT_5 11
 
-#define MAGIC_ROOK_NUM_6 0x200071428820008ULL
+#define MAGIC_ROOK_NUM_6 0x400008210010408ULL
 #define MAGIC_ROOK_SHIFT_6 11
 
-#define MAGIC_ROOK_NUM_7 0x880132041000080ULL
+#define MAGIC_ROOK_NUM_7 0x4100020828804100ULL
 #define MAGIC_ROOK_SHIFT_7 12
 
-#define MAGIC_ROOK_NUM_8 0x9002108800042ULL
+#define MAGIC_ROOK_NUM_8 0x48800080400020ULL
 #define MAGIC_ROOK_SHIFT_8 11
 
-#define MAGIC_ROOK_NUM_9 0x44c401000200040ULL
+#define MAGIC_ROOK_NUM_9 0x84802000400081ULL
 #define MAGIC_ROOK_SHIFT_9 10
 
-#define MAGIC_ROOK_NUM_10 0x4001002005044050ULL
+#define MAGIC_ROOK_NUM_10 0x4000808020001000ULL
 #define MAGIC_ROOK_SHIFT_10 10
 
-#define MAGIC_ROOK_NUM_11 0x1000900100064ULL
+#define MAGIC_ROOK_NUM_11 0x1a000a02401020ULL
 #define MAGIC_ROOK_SHIFT_11 10
 
-#define MAGIC_ROOK_NUM_12 0x1001800110006ULL
+#define MAGIC_ROOK_NUM_12 0x22001022000804ULL
 #define MAGIC_ROOK_SHIFT_12 10
 
-#define MAGIC_ROOK_NUM_13 0xa005005080200ULL
+#define MAGIC_ROOK_NUM_13 0x5618800200800400ULL
 #define MAGIC_ROOK_SHIFT_13 10
 
-#define MAGIC_ROOK_NUM_14 0x209002100240200ULL
+#define MAGIC_ROOK_NUM_14 0x11000100020004ULL
 #define MAGIC_ROOK_SHIFT_14 10
 
-#define MAGIC_ROOK_NUM_15 0x43000200804300ULL
+#define MAGIC_ROOK_NUM_15 0x5000092004100ULL
 #define MAGIC_ROOK_SHIFT_15 11
 
-#define MAGIC_ROOK_NUM_16 0x40228008884000ULL
+#define MAGIC_ROOK_NUM_16 0x280004000402000ULL
 #define MAGIC_ROOK_SHIFT_16 11
 
-#define MAGIC_ROOK_NUM_17 0x102020020804104ULL
+#define MAGIC_ROOK_NUM_17 0x808020004006ULL
 #define MAGIC_ROOK_SHIFT_17 10
 
-#define MAGIC_ROOK_NUM_18 0x80430020010032ULL
+#define MAGIC_ROOK_NUM_18 0x81050040200010ULL
 #define MAGIC_ROOK_SHIFT_18 10
 
-#define MAGIC_ROOK_NUM_19 0x8410100200c1001ULL
+#define MAGIC_ROOK_NUM_19 0x4405090010010020ULL
 #define MAGIC_ROOK_SHIFT_19 10
 
-#define MAGIC_ROOK_NUM_20 0x1200d0008010090ULL
+#define MAGIC_ROOK_NUM_20 0x8020808008000400ULL
 #define MAGIC_ROOK_SHIFT_20 10
 
-#define MAGIC_ROOK_NUM_21 0x39010100080e0400ULL
+#define MAGIC_ROOK_NUM_21 0x420080110400420ULL
 #define MAGIC_ROOK_SHIFT_21 10
 
-#define MAGIC_ROOK_NUM_22 0x80140001100208ULL
+#define MAGIC_ROOK_NUM_22 0x8200040001287002ULL
 #define MAGIC_ROOK_SHIFT_22 10
 
-#define MAGIC_ROOK_NUM_23 0x200024c05a1ULL
+#define MAGIC_ROOK_NUM_23 0x80660001811254ULL
 #define MAGIC_ROOK_SHIFT_23 11
 
-#define MAGIC_ROOK_NUM_24 0x180004040002010ULL
+#define MAGIC_ROOK_NUM_24 0x1000400680008824ULL
 #define MAGIC_ROOK_SHIFT_24 11
 
-#define MAGIC_ROOK_NUM_25 0x1010064040002000ULL
+#define MAGIC_ROOK_NUM_25 0x200500040002000ULL
 #define MAGIC_ROOK_SHIFT_25 10
 
-#define MAGIC_ROOK_NUM_26 0x41044500200012ULL
+#define MAGIC_ROOK_NUM_26 0x1410100080200080ULL
 #define MAGIC_ROOK_SHIFT_26 10
 
-#define MAGIC_ROOK_NUM_27 0x9020900205000ULL
+#define MAGIC_ROOK_NUM_27 0x848100080080081ULL
 #define MAGIC_ROOK_SHIFT_27 10
 
-#define MAGIC_ROOK_NUM_28 0x4402002200150810ULL
+#define MAGIC_ROOK_NUM_28 0x6080080040081ULL
 #define MAGIC_ROOK_SHIFT_28 10
 
-#define MAGIC_ROOK_NUM_29 0x4001040801102040ULL
+#define MAGIC_ROOK_NUM_29 0xc884020080800400ULL
 #define MAGIC_ROOK_SHIFT_29 10
 
-#define MAGIC_ROOK_NUM_30 0x4241000101020004ULL
+#define MAGIC_ROOK_NUM_30 0x1001982400020110ULL
 #define MAGIC_ROOK_SHIFT_30 10
 
-#define MAGIC_ROOK_NUM_31 0x8108a0021004cULL
+#define MAGIC_ROOK_NUM_31 0x410200008044ULL
 #define MAGIC_ROOK_SHIFT_31 11
 
-#define MAGIC_ROOK_NUM_32 0x80004000402004ULL
+#define MAGIC_ROOK_NUM_32 0x400085800822ULL
 #define MAGIC_ROOK_SHIFT_32 11
 
-#define MAGIC_ROOK_NUM_33 0x125201000400042ULL
+#define MAGIC_ROOK_NUM_33 0x440040088c802000ULL
 #define MAGIC_ROOK_SHIFT_33 10
 
-#define MAGIC_ROOK_NUM_34 0x4000401301002001ULL
+#define MAGIC_ROOK_NUM_34 0x1880801000802000ULL
 #define MAGIC_ROOK_SHIFT_34 10
 
-#define MAGIC_ROOK_NUM_35 0x519000a21001000ULL
+#define MAGIC_ROOK_NUM_35 0x208020010100100ULL
 #define MAGIC_ROOK_SHIFT_35 10
 
-#define MAGIC_ROOK_NUM_36 0x308008008804401ULL
+#define MAGIC_ROOK_NUM_36 0x28008048800400ULL
 #define MAGIC_ROOK_SHIFT_36 10
 
-#define MAGIC_ROOK_NUM_37 0x2000832007024ULL
+#define MAGIC_ROOK_NUM_37 0x8112800200800400ULL
 #define MAGIC_ROOK_SHIFT_37 10
 
-#define MAGIC_ROOK_NUM_38 0x1100104002802ULL
+#define MAGIC_ROOK_NUM_38 0x8002100204000801ULL
 #define MAGIC_ROOK_SHIFT_38 10
 
-#define MAGIC_ROOK_NUM_39 0x68008402001069ULL
+#define MAGIC_ROOK_NUM_39 0x8000008042000401ULL
 #define MAGIC_ROOK_SHIFT_39 11
 
-#define MAGIC_ROOK_NUM_40 0x80004020044002ULL
+#define MAGIC_ROOK_NUM_40 0x2800040028022ULL
 #define MAGIC_ROOK_SHIFT_40 11
 
-#define MAGIC_ROOK_NUM_41 0x4090014020024000ULL
+#define MAGIC_ROOK_NUM_41 0x290002000404004ULL
 #define MAGIC_ROOK_SHIFT_41 10
 
-#define MAGIC_ROOK_NUM_42 0x559006000350040ULL
+#define MAGIC_ROOK_NUM_42 0x8000208012020042ULL
 #define MAGIC_ROOK_SHIFT_42 10
 
-#define MAGIC_ROOK_NUM_43 0x2021090010010022ULL
+#define MAGIC_ROOK_NUM_43 0x10080010008080ULL
 #define MAGIC_ROOK_SHIFT_43 10
 
-#define MAGIC_ROOK_NUM_44 0x4008040080800ULL
+#define MAGIC_ROOK_NUM_44 0x206001020860008ULL
 #define MAGIC_ROOK_SHIFT_44 10
 
-#define MAGIC_ROOK_NUM_45 0x10100a214010008ULL
+#define MAGIC_ROOK_NUM_45 0x201000804010002ULL
 #define MAGIC_ROOK_SHIFT_45 10
 
-#define MAGIC_ROOK_NUM_46 0x240900020041001cULL
+#define MAGIC_ROOK_NUM_46 0x8044580210140001ULL
 #define MAGIC_ROOK_SHIFT_46 10
 
-#define MAGIC_ROOK_NUM_47 0x122089100420004ULL
+#define MAGIC_ROOK_NUM_47 0xc0065820001ULL
 #define MAGIC_ROOK_SHIFT_47 11
 
-#define MAGIC_ROOK_NUM_48 0x800400022800080ULL
+#define MAGIC_ROOK_NUM_48 0x840400020800080ULL
 #define MAGIC_ROOK_SHIFT_48 11
 
-#define MAGIC_ROOK_NUM_49 0x20024004802080ULL
+#define MAGIC_ROOK_NUM_49 0x9000401000200040ULL
 #define MAGIC_ROOK_SHIFT_49 10
 
-#define MAGIC_ROOK_NUM_50 0x1014020041100ULL
+#define MAGIC_ROOK_NUM_50 0x1002802000100480ULL
 #define MAGIC_ROOK_SHIFT_50 10
 
-#define MAGIC_ROOK_NUM_51 0x10001020408a0200ULL
+#define MAGIC_ROOK_NUM_51 0xc8c081000210100ULL
 #define MAGIC_ROOK_SHIFT_51 10
 
-#define MAGIC_ROOK_NUM_52 0x118003400420040ULL
+#define MAGIC_ROOK_NUM_52 0x2400080011000500ULL
 #define MAGIC_ROOK_SHIFT_52 10
 
-#define MAGIC_ROOK_NUM_53 0x204204064100801ULL
+#define MAGIC_ROOK_NUM_53 0x800400020080ULL
 #define MAGIC_ROOK_SHIFT_53 10
 
-#define MAGIC_ROOK_NUM_54 0x100052208100400ULL
+#define MAGIC_ROOK_NUM_54 0x400820190080400ULL
 #define MAGIC_ROOK_SHIFT_54 10
 
-#define MAGIC_ROOK_NUM_55 0x6021b0401804600ULL
+#define MAGIC_ROOK_NUM_55 0x4104108200ULL
 #define MAGIC_ROOK_SHIFT_55 11
 
-#define MAGIC_ROOK_NUM_56 0x5020010864022ULL
+#define MAGIC_ROOK_NUM_56 0x40800221004113ULL
 #define MAGIC_ROOK_SHIFT_56 12
 
-#define MAGIC_ROOK_NUM_57 0x4100400124810451ULL
+#define MAGIC_ROOK_NUM_57 0x2104005882101ULL
 #define MAGIC_ROOK_SHIFT_57 11
 
-#define MAGIC_ROOK_NUM_58 0x5400082000104101ULL
+#define MAGIC_ROOK_NUM_58 0x208010400a02ULL
 #define MAGIC_ROOK_SHIFT_58 11
 
-#define MAGIC_ROOK_NUM_59 0xc041001a10009ULL
+#define MAGIC_ROOK_NUM_59 0x2021000804201001ULL
 #define MAGIC_ROOK_SHIFT_59 11
 
-#define MAGIC_ROOK_NUM_60 0x8200a010444806ULL
+#define MAGIC_ROOK_NUM_60 0x2010410082002ULL
 #define MAGIC_ROOK_SHIFT_60 11
 
-#define MAGIC_ROOK_NUM_61 0x902000310080452ULL
+#define MAGIC_ROOK_NUM_61 0x20b000a18240005ULL
 #define MAGIC_ROOK_SHIFT_61 11
 
-#define MAGIC_ROOK_NUM_62 0x8c0224810010284ULL
+#define MAGIC_ROOK_NUM_62 0x100081282204ULL
 #define MAGIC_ROOK_SHIFT_62 11
 
-#define MAGIC_ROOK_NUM_63 0x900040300624082ULL
+#define MAGIC_ROOK_NUM_63 0x100140428428102ULL
 #define MAGIC_ROOK_SHIFT_63 12
 
 // ======= BISHOPS =========
 
-#define MAGIC_BISHOP_NUM_0 0x240c0410440100ULL
+#define MAGIC_BISHOP_NUM_0 0x48105000842080ULL
 #define MAGIC_BISHOP_SHIFT_0 6
 
-#define MAGIC_BISHOP_NUM_1 0x820080109103000ULL
+#define MAGIC_BISHOP_NUM_1 0x8190920840448010ULL
 #define MAGIC_BISHOP_SHIFT_1 5
 
-#define MAGIC_BISHOP_NUM_2 0x88060146002406ULL
+#define MAGIC_BISHOP_NUM_2 0x130040259490020ULL
 #define MAGIC_BISHOP_SHIFT_2 5
 
-#define MAGIC_BISHOP_NUM_3 0xa180a0464000e00ULL
+#define MAGIC_BISHOP_NUM_3 0x4c8208020000020ULL
 #define MAGIC_BISHOP_SHIFT_3 5
 
-#define MAGIC_BISHOP_NUM_4 0x204030800202000ULL
+#define MAGIC_BISHOP_NUM_4 0x1014042102602005ULL
 #define MAGIC_BISHOP_SHIFT_4 5
 
-#define MAGIC_BISHOP_NUM_5 0x22018460600405ULL
+#define MAGIC_BISHOP_NUM_5 0x8081040240042808ULL
 #define MAGIC_BISHOP_SHIFT_5 5
 
-#define MAGIC_BISHOP_NUM_6 0x408a010402401031ULL
+#define MAGIC_BISHOP_NUM_6 0x902009008089c10ULL
 #define MAGIC_BISHOP_SHIFT_6 5
 
-#define MAGIC_BISHOP_NUM_7 0x2800220504014018ULL
+#define MAGIC_BISHOP_NUM_7 0x400110082104080ULL
 #define MAGIC_BISHOP_SHIFT_7 6
 
-#define MAGIC_BISHOP_NUM_8 0x1012044c28081120ULL
+#define MAGIC_BISHOP_NUM_8 0x202040808481080ULL
 #define MAGIC_BISHOP_SHIFT_8 5
 
-#define MAGIC_BISHOP_NUM_9 0x400080801004206ULL
+#define MAGIC_BISHOP_NUM_9 0x2100030202040101ULL
 #define MAGIC_BISHOP_SHIFT_9 5
 
-#define MAGIC_BISHOP_NUM_10 0x480801043000ULL
+#define MAGIC_BISHOP_NUM_10 0x1180225084008040ULL
 #define MAGIC_BISHOP_SHIFT_10 5
 
-#define MAGIC_BISHOP_NUM_11 0x102040400920801ULL
+#define MAGIC_BISHOP_NUM_11 0x810044040800025ULL
 #define MAGIC_BISHOP_SHIFT_11 5
 
-#define MAGIC_BISHOP_NUM_12 0x40a0a0210100800ULL
+#define MAGIC_BISHOP_NUM_12 0x1038240420220240ULL
 #define MAGIC_BISHOP_SHIFT_12 5
 
-#define MAGIC_BISHOP_NUM_13 0x80082410180011ULL
+#define MAGIC_BISHOP_NUM_13 0x8100020210048400ULL
 #define MAGIC_BISHOP_SHIFT_13 5
 
-#define MAGIC_BISHOP_NUM_14 0x108c808080804ULL
+#define MAGIC_BISHOP_NUM_14 0x407c06180c0621ULL
 #define MAGIC_BISHOP_SHIFT_14 5
 
-#define MAGIC_BISHOP_NUM_15 0x44421a7080a10a0ULL
+#define MAGIC_BISHOP_NUM_15 0x4101002401241081ULL
 #define MAGIC_BISHOP_SHIFT_15 5
 
-#define MAGIC_BISHOP_NUM_16 0x4044044808500401ULL
+#define MAGIC_BISHOP_NUM_16 0x24042060340500ULL
 #define MAGIC_BISHOP_SHIFT_16 5
 
-#define MAGIC_BISHOP_NUM_17 0x24f0010310311500ULL
+#define MAGIC_BISHOP_NUM_17 0x2a0001001121080ULL
 #define MAGIC_BISHOP_SHIFT_17 5
 
-#define MAGIC_BISHOP_NUM_18 0x114800040044000cULL
+#define MAGIC_BISHOP_NUM_18 0x50a086048004081ULL
 #define MAGIC_BISHOP_SHIFT_18 7
 
-#define MAGIC_BISHOP_NUM_19 0x58008402102402ULL
+#define MAGIC_BISHOP_NUM_19 0x4d24014840400900ULL
 #define MAGIC_BISHOP_SHIFT_19 7
 
-#define MAGIC_BISHOP_NUM_20 0x4801020820080485ULL
+#define MAGIC_BISHOP_NUM_20 0x2008422010420ULL
 #define MAGIC_BISHOP_SHIFT_20 7
 
-#define MAGIC_BISHOP_NUM_21 0x2100204100884001ULL
+#define MAGIC_BISHOP_NUM_21 0x805002600420223ULL
 #define MAGIC_BISHOP_SHIFT_21 7
 
-#define MAGIC_BISHOP_NUM_22 0x401000209500208ULL
+#define MAGIC_BISHOP_NUM_22 0x201004211100201ULL
 #define MAGIC_BISHOP_SHIFT_22 5
 
-#define MAGIC_BISHOP_NUM_23 0x1001208908980400ULL
+#define MAGIC_BISHOP_NUM_23 0x200818244040140ULL
 #define MAGIC_BISHOP_SHIFT_23 5
 
-#define MAGIC_BISHOP_NUM_24 0x4140c0040482800ULL
+#define MAGIC_BISHOP_NUM_24 0x80428800a0083040ULL
 #define MAGIC_BISHOP_SHIFT_24 5
 
-#define MAGIC_BISHOP_NUM_25 0x6100142140803ULL
+#define MAGIC_BISHOP_NUM_25 0x10094062220420ULL
 #define MAGIC_BISHOP_SHIFT_25 5
 
-#define MAGIC_BISHOP_NUM_26 0x4010850084088ULL
+#define MAGIC_BISHOP_NUM_26 0x148010008004101ULL
 #define MAGIC_BISHOP_SHIFT_26 7
 
-#define MAGIC_BISHOP_NUM_27 0x224800008200c0ULL
+#define MAGIC_BISHOP_NUM_27 0x1304080104202040ULL
 #define MAGIC_BISHOP_SHIFT_27 9
 
-#define MAGIC_BISHOP_NUM_28 0x121010001514001ULL
+#define MAGIC_BISHOP_NUM_28 0x4201001041004000ULL
 #define MAGIC_BISHOP_SHIFT_28 9
 
-#define MAGIC_BISHOP_NUM_29 0x212058044100093ULL
+#define MAGIC_BISHOP_NUM_29 0x611202410080aULL
 #define MAGIC_BISHOP_SHIFT_29 7
 
-#define MAGIC_BISHOP_NUM_30 0x523004044020824ULL
+#define MAGIC_BISHOP_NUM_30 0x801000200d240ULL
 #define MAGIC_BISHOP_SHIFT_30 5
 
-#define MAGIC_BISHOP_NUM_31 0xa410664410c0102ULL
+#define MAGIC_BISHOP_NUM_31 0x6080aa0000220200ULL
 #define MAGIC_BISHOP_SHIFT_31 5
 
-#define MAGIC_BISHOP_NUM_32 0x204168910401020ULL
+#define MAGIC_BISHOP_NUM_32 0x4250420401010ULL
 #define MAGIC_BISHOP_SHIFT_32 5
 
-#define MAGIC_BISHOP_NUM_33 0xc4242001040190ULL
+#define MAGIC_BISHOP_NUM_33 0x801210800101048ULL
 #define MAGIC_BISHOP_SHIFT_33 5
 
-#define MAGIC_BISHOP_NUM_34 0x4408108800300040ULL
+#define MAGIC_BISHOP_NUM_34 0x41c040400121220ULL
 #define MAGIC_BISHOP_SHIFT_34 7
 
-#define MAGIC_BISHOP_NUM_35 0x820401048320200ULL
+#define MAGIC_BISHOP_NUM_35 0x2420280680080ULL
 #define MAGIC_BISHOP_SHIFT_35 9
 
-#define MAGIC_BISHOP_NUM_36 0x4040400411100ULL
+#define MAGIC_BISHOP_NUM_36 0x8042400044100ULL
 #define MAGIC_BISHOP_SHIFT_36 9
 
-#define MAGIC_BISHOP_NUM_37 0x4002020c100e0043ULL
+#define MAGIC_BISHOP_NUM_37 0x108a0480041001ULL
 #define MAGIC_BISHOP_SHIFT_37 7
 
-#define MAGIC_BISHOP_NUM_38 0x5068084101004101ULL
+#define MAGIC_BISHOP_NUM_38 0x48221080024848ULL
 #define MAGIC_BISHOP_SHIFT_38 5
 
-#define MAGIC_BISHOP_NUM_39 0x8010020204224ULL
+#define MAGIC_BISHOP_NUM_39 0x204004244020d00ULL
 #define MAGIC_BISHOP_SHIFT_39 5
 
-#define MAGIC_BISHOP_NUM_40 0x584300210000800ULL
+#define MAGIC_BISHOP_NUM_40 0xe0010c9040204408ULL
 #define MAGIC_BISHOP_SHIFT_40 5
 
-#define MAGIC_BISHOP_NUM_41 0x460c0488040c0800ULL
+#define MAGIC_BISHOP_NUM_41 0x40a4020110440404ULL
 #define MAGIC_BISHOP_SHIFT_41 5
 
-#define MAGIC_BISHOP_NUM_42 0x4040108404004040ULL
+#define MAGIC_BISHOP_NUM_42 0x800330803004800ULL
 #define MAGIC_BISHOP_SHIFT_42 7
 
-#define MAGIC_BISHOP_NUM_43 0x2218020c00ULL
+#define MAGIC_BISHOP_NUM_43 0x8008002018010101ULL
 #define MAGIC_BISHOP_SHIFT_43 7
 
-#define MAGIC_BISHOP_NUM_44 0x40850100600ULL
+#define MAGIC_BISHOP_NUM_44 0x2082000a0810c02ULL
 #define MAGIC_BISHOP_SHIFT_44 7
 
-#define MAGIC_BISHOP_NUM_45 0x20090202044020ULL
+#define MAGIC_BISHOP_NUM_45 0x10600080204102ULL
 #define MAGIC_BISHOP_SHIFT_45 7
 
-#define MAGIC_BISHOP_NUM_46 0x242102200802208ULL
+#define MAGIC_BISHOP_NUM_46 0xcf0c10109000400ULL
 #define MAGIC_BISHOP_SHIFT_46 5
 
-#define MAGIC_BISHOP_NUM_47 0x1208108100400208ULL
+#define MAGIC_BISHOP_NUM_47 0x284480040400104ULL
 #define MAGIC_BISHOP_SHIFT_47 5
 
-#define MAGIC_BISHOP_NUM_48 0x2804480410c80302ULL
+#define MAGIC_BISHOP_NUM_48 0x4000840120100002ULL
 #define MAGIC_BISHOP_SHIFT_48 5
 
-#define MAGIC_BISHOP_NUM_49 0x100220110080000ULL
+#define MAGIC_BISHOP_NUM_49 0x1048094a00841ULL
 #define MAGIC_BISHOP_SHIFT_49 5
 
-#define MAGIC_BISHOP_NUM_50 0x20042280200ULL
+#define MAGIC_BISHOP_NUM_50 0xa1004044100022ULL
 #define MAGIC_BISHOP_SHIFT_50 5
 
-#define MAGIC_BISHOP_NUM_51 0x40220880604ULL
+#define MAGIC_BISHOP_NUM_51 0x48109084040001ULL
 #define MAGIC_BISHOP_SHIFT_51 5
 
-#define MAGIC_BISHOP_NUM_52 0x180008e014240200ULL
+#define MAGIC_BISHOP_NUM_52 0x5040a102022008cULL
 #define MAGIC_BISHOP_SHIFT_52 5
 
-#define MAGIC_BISHOP_NUM_53 0x84280208020000ULL
+#define MAGIC_BISHOP_NUM_53 0xa85840850044000ULL
 #define MAGIC_BISHOP_SHIFT_53 5
 
-#define MAGIC_BISHOP_NUM_54 0x114080208120010ULL
+#define MAGIC_BISHOP_NUM_54 0x420600282044450ULL
 #define MAGIC_BISHOP_SHIFT_54 5
 
-#define MAGIC_BISHOP_NUM_55 0x810500200802200ULL
+#define MAGIC_BISHOP_NUM_55 0x2030024204082080ULL
 #define MAGIC_BISHOP_SHIFT_55 5
 
-#define MAGIC_BISHOP_NUM_56 0x2030202402084000ULL
+#define MAGIC_BISHOP_NUM_56 0x6020110410020820ULL
 #define MAGIC_BISHOP_SHIFT_56 6
 
-#define MAGIC_BISHOP_NUM_57 0x1040220200920800ULL
+#define MAGIC_BISHOP_NUM_57 0x802e0510481bULL
 #define MAGIC_BISHOP_SHIFT_57 5
 
-#define MAGIC_BISHOP_NUM_58 0x2000200200840410ULL
+#define MAGIC_BISHOP_NUM_58 0x810000240541000ULL
 #define MAGIC_BISHOP_SHIFT_58 5
 
-#define MAGIC_BISHOP_NUM_59 0x92d0000842411ULL
+#define MAGIC_BISHOP_NUM_59 0x2820091010840440ULL
 #define MAGIC_BISHOP_SHIFT_59 5
 
-#define MAGIC_BISHOP_NUM_60 0x4001308110421a00ULL
+#define MAGIC_BISHOP_NUM_60 0x400201190020220ULL
 #define MAGIC_BISHOP_SHIFT_60 5
 
-#define MAGIC_BISHOP_NUM_61 0x1904000c10041842ULL
+#define MAGIC_BISHOP_NUM_61 0x2020000420042d0cULL
 #define MAGIC_BISHOP_SHIFT_61 5
 
-#define MAGIC_BISHOP_NUM_62 0x1000409202121201ULL
+#define MAGIC_BISHOP_NUM_62 0x806028900c480040ULL
 #define MAGIC_BISHOP_SHIFT_62 5
 
-#define MAGIC_BISHOP_NUM_63 0x880a1002002104ULL
+#define MAGIC_BISHOP_NUM_63 0xc208010438004101ULL
 #define MAGIC_BISHOP_SHIFT_63 6
-#include <stdint.h>
 
 static const uint64_t MAGIC_ROOK_NUMS[64] = {
     MAGIC_ROOK_NUM_0,
@@ -660,4 +665,4 @@ static const uint8_t MAGIC_BISHOP_SHIFTS[64] = {
     MAGIC_BISHOP_SHIFT_63,
 };
 
-#endif //MAGIC_H
\ No newline at end of file
+#endif //MAGIC_H
@@ -6,12 +6,212 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdbool.h>
+#include <string.h>
 #include <ctype.h>
 #include "constants.h"
 #include "utils.h"
+#include "attacks.h"
+#include "zobrist.h"
+#include "perft.h"
+#include "bench.h"
+#include "search.h"
+#include "eval.h"
+#include "nnue.h"
+#include "see.h"
+#include "uci.h"
+#include "mcts.h"
+#include "batch.h"
 
-void main() {
-    const char* FEN_start = "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1";
-    Bitboard board = init_Bitboard(FEN_start);
-    print_board(board);
-}
\ No newline at end of file
+static const char* FEN_start = "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1";
+
+// FENs contain spaces, so everything after the fixed arguments is joined back into one string.
+static const char* fen_from_args(int argc, char** argv, int first, char* buffer, size_t size) {
+    if (first >= argc) return FEN_start;
+    buffer[0] = '\0';
+    for (int i = first; i < argc; i++) {
+        if (i > first) strncat(buffer, " ", size - strlen(buffer) - 1);
+        strncat(buffer, argv[i], size - strlen(buffer) - 1);
+    }
+    return buffer;
+}
+
+static void usage(void) {
+    fprintf(stderr,
+            "usage: chess                         UCI mode (also: chess uci)\n"
+            "       chess board [fen]             print a position\n"
+            "       chess perft <depth> [fen]     count leaves (make/unmake)\n"
+            "       chess perft-copy <depth> [fen]  count leaves (copy-make)\n"
+            "       chess divide <depth> [fen]    leaf count per root move\n"
+            "       chess perft-mt <depth> <threads> <hash-mb> [fen]  parallel perft with a shared hash\n"
+            "       chess perft-suite [depth]     standard positions vs known counts\n"
+            "       chess bench-attacks [lookups] slider lookup latency, packed vs dense tables\n"
+            "       chess see-suite               check SEE against known exchange values\n"
+            "       chess bench-see [calls]       SEE latency over captures from random games\n"
+            "       chess search <depth> [fen]    iterative-deepening search to a fixed depth\n"
+            "       chess bench [depth] [eval-cache-kb]  fixed-depth search over the bench positions\n"
+            "       chess mcts <playouts> [threads] [fen]  Monte Carlo tree search\n"
+            "       chess bench-mcts [playouts] [max-threads]  MCTS playouts/sec and subtree reuse\n"
+            "       chess batch <fen-file> [depth] [threads]  score one FEN per line (static eval at depth 0)\n"
+            "       chess bench-batch [positions] [depth] [max-threads]  batch positions/sec, static and searched\n"
+            "       chess bench-smp <depth> [max-threads]  Lazy SMP time-to-depth for 1, 2, 4, ... threads\n"
+            "       chess bench-eval [network]    evaluations/sec, handcrafted vs NNUE\n"
+            "       chess nnue-export <path>      write a network built from the piece-square tables\n"
+            "       chess params                  list the search parameters\n"
+            "\n"
+            "Search parameters can be set before any command: chess lmr_base=50 bench 8\n");
+}
+
+int main(int argc, char** argv) {
+    char fen[256];
+    init_attacks();
+    init_zobrist();
+    init_eval();
+    init_nnue();
+    init_search();
+
+    // Leading name=value arguments set search parameters.
+    while (argc > 1 && strchr(argv[1], '=')) {
+        char name[64];
+        const char* eq = strchr(argv[1], '=');
+        const size_t length = (size_t)(eq - argv[1]) < sizeof(name) - 1 ? (size_t)(eq - argv[1]) : sizeof(name) - 1;
+        memcpy(name, argv[1], length);
+        name[length] = '\0';
+        if (!search_set_param(name, atoi(eq + 1))) {
+            fprintf(stderr, "Unknown search parameter or value out of range: %s\n", argv[1]);
+            return EXIT_FAILURE;
+        }
+        argv++;
+        argc--;
+    }
+
+    // GUIs start the engine without arguments.
+    if (argc < 2 || strcmp(argv[1], "uci") == 0) {
+        uci_loop();
+        return 0;
+    }
+
+    const char* command = argv[1];
+    if (strcmp(command, "board") == 0) {
+        Bitboard board = init_Bitboard(fen_from_args(argc, argv, 2, fen, sizeof(fen)));
+        print_board(board);
+        return 0;
+    }
+
+    if (strcmp(command, "perft-suite") == 0) {
+        return perft_suite(argc > 2 ? atoi(argv[2]) : 0) ? EXIT_FAILURE : EXIT_SUCCESS;
+    }
+
+    if (strcmp(command, "see-suite") == 0) {
+        return see_suite() ? EXIT_FAILURE : EXIT_SUCCESS;
+    }
+
+    if (strcmp(command, "bench-see") == 0) {
+        bench_see(argc > 2 ? strtoull(argv[2], NULL, 10) : 10000000ULL);
+        return 0;
+    }
+
+    if (strcmp(command, "bench-attacks") == 0) {
+        bench_attacks(argc > 2 ? strtoull(argv[2], NULL, 10) : 100000000ULL);
+        return 0;
+    }
+
+    if (strcmp(command, "bench") == 0) {
+        if (argc > 3) search_set_eval_cache(strtoull(argv[3], NULL, 10));
+        bench_search(argc > 2 ? atoi(argv[2]) : 7);
+        return 0;
+    }
+
+    if (strcmp(command, "params") == 0) {
+        for (int i = 0; i < SEARCH_PARAM_COUNT; i++) {
+            const SearchParam* p = &SEARCH_PARAMS[i];
+            printf("%-20s %6d  (default %d, range %d..%d)\n", p->name, *p->value, p->default_value, p->min, p->max);
+        }
+        return 0;
+    }
+
+    if (strcmp(command, "bench-smp") == 0 && argc > 2) {
+        bench_smp(atoi(argv[2]), argc > 3 ? atoi(argv[3]) : 32);
+        return 0;
+    }
+
+    if (strcmp(command, "bench-eval") == 0) {
+        bench_eval(argc > 2 ? argv[2] : NULL, 20);
+        return 0;
+    }
+
+    if (strcmp(command, "nnue-export") == 0 && argc > 2) {
+        if (!nnue_export(argv[2])) {
+            fprintf(stderr, "Cannot write %s\n", argv[2]);
+            return EXIT_FAILURE;
+        }
+        return 0;
+    }
+
+    if (strcmp(command, "search") == 0 && argc > 2) {
+        Bitboard board = init_Bitboard(fen_from_args(argc, argv, 3, fen, sizeof(fen)));
+        const SearchLimits limits = {.depth = atoi(argv[2])};
+        SearchResult result;
+        char move[6];
+        search_position(&board, NULL, 0, &limits, &result);
+        move_to_string(result.best_move, move);
+        printf("bestmove %s\n", result.best_move ? move : "0000");
+        return 0;
+    }
+
+    if (strcmp(command, "mcts") == 0 && argc > 2) {
+        Bitboard board = init_Bitboard(fen_from_args(argc, argv, 4, fen, sizeof(fen)));
+        const SearchLimits limits = {.nodes = strtoull(argv[2], NULL, 10), .threads = argc > 3 ? atoi(argv[3]) : 1};
+        SearchResult result;
+        char move[6];
+        mcts_search(&board, NULL, 0, &limits, &result);
+        move_to_string(result.best_move, move);
+        printf("bestmove %s\n", result.best_move ? move : "0000");
+        return 0;
+    }
+
+    if (strcmp(command, "bench-mcts") == 0) {
+        bench_mcts(argc > 2 ? strtoull(argv[2], NULL, 10) : 200000ULL, argc > 3 ? atoi(argv[3]) : 4);
+        return 0;
+    }
+
+    if (strcmp(command, "batch") == 0 && argc > 2) {
+        if (!batch_score_file(argv[2], argc > 3 ? atoi(argv[3]) : 0, argc > 4 ? atoi(argv[4]) : 1)) {
+            fprintf(stderr, "Cannot read %s\n", argv[2]);
+            return EXIT_FAILURE;
+        }
+        return 0;
+    }
+
+    if (strcmp(command, "bench-batch") == 0) {
+        bench_batch(argc > 2 ? strtoull(argv[2], NULL, 10) : 10000, argc > 3 ? atoi(argv[3]) : 4,
+                    argc > 4 ? atoi(argv[4]) : 4);
+        return 0;
+    }
+
+    if (strcmp(command, "perft-mt") == 0 && argc > 4) {
+        Bitboard board = init_Bitboard(fen_from_args(argc, argv, 5, fen, sizeof(fen)));
+        perft_parallel(&board, atoi(argv[2]), atoi(argv[3]), (size_t)atoi(argv[4]));
+        return 0;
+    }
+
+    if ((strcmp(command, "perft") == 0 || strcmp(command, "perft-copy") == 0 ||
+         strcmp(command, "divide") == 0) && argc > 2) {
+        const int depth = atoi(argv[2]);
+        Bitboard board = init_Bitboard(fen_from_args(argc, argv, 3, fen, sizeof(fen)));
+
+        if (strcmp(command, "divide") == 0) {
+            perft_divide(&board, depth);
+            return 0;
+        }
+
+        const uint64_t start = time_now_ns();
+        const uint64_t nodes = strcmp(command, "perft") == 0 ? perft(&board, depth) : perft_copy(board, depth);
+        const double seconds = (double)(time_now_ns() - start) / 1e9;
+        printf("Nodes: %llu  Time: %.3f s  NPS: %.0f\n",
+               (unsigned long long)nodes, seconds, seconds > 0 ? (double)nodes / seconds : 0.0);
+        return 0;
+    }
+
+    usage();
+    return EXIT_FAILURE;
+}
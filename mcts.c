@@ -0,0 +1,469 @@
+//
+// Created by lenovo on 10/18/2026.
+//
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <math.h>
+#include <stdatomic.h>
+#include "constants.h"
+#include "bitboard.h"
+#include "move.h"
+#include "movegeneration.h"
+#include "eval.h"
+#include "pawns.h"
+#include "nnue.h"
+#include "search.h"
+#include "threadpool.h"
+#include "timeman.h"
+#include "utils.h"
+#include "mcts.h"
+
+#define MCTS_EXPLORATION    1.2     // UCT constant, values in [0, 1]
+#define MCTS_CP_SCALE       250.0   // centipawns to win probability: 1 / (1 + e^(-cp / scale))
+#define MCTS_CHECK_PLAYOUTS 256     // power of two: how often the main thread checks the limits
+#define MCTS_INFO_NS        1000000000ULL
+
+// --- Tree ---
+
+typedef struct {
+    MctsNode* nodes;            // nodes[0] is the root
+    MctsNode* spare;            // same size: a kept subtree is copied here, then the two swap
+    size_t capacity;            // nodes per arena
+    _Atomic size_t used;        // may run past capacity once the arena is full
+    Bitboard root;              // position of nodes[0], when has_root
+    bool has_root;
+} MctsTree;
+
+static MctsTree tree;
+static size_t tree_mb = MCTS_DEFAULT_MB;
+
+static void reset_tree(const Bitboard* root) {
+    MctsNode* node = &tree.nodes[0];
+    atomic_store_explicit(&node->value, 0, memory_order_relaxed);
+    atomic_store_explicit(&node->visits, 0, memory_order_relaxed);
+    node->first_child = 0;
+    node->child_count = 0;
+    node->move = MOVE_NONE;
+    atomic_store_explicit(&node->state, MCTS_LEAF, memory_order_relaxed);
+    atomic_store_explicit(&tree.used, 1, memory_order_relaxed);
+    tree.root = *root;
+    tree.root.nnue = NULL;
+    tree.has_root = true;
+}
+
+void mcts_set_memory(const size_t mb) {
+    free(tree.nodes);
+    free(tree.spare);
+    tree_mb = mb;
+    tree.capacity = mb * 1024 * 1024 / 2 / sizeof(MctsNode);
+    if (tree.capacity < 1) tree.capacity = 1;
+    tree.nodes = malloc(tree.capacity * sizeof(MctsNode));
+    tree.spare = malloc(tree.capacity * sizeof(MctsNode));
+    if (!tree.nodes || !tree.spare) {
+        fprintf(stderr, "Failed to allocate a %zu MB search tree\n", mb);
+        exit(EXIT_FAILURE);
+    }
+    tree.has_root = false;
+}
+
+void mcts_clear(void) {
+    tree.has_root = false;
+}
+
+size_t mcts_tree_nodes(void) {
+    if (!tree.has_root) return 0;
+    const size_t used = atomic_load(&tree.used);
+    return used < tree.capacity ? used : tree.capacity;
+}
+
+// Copies the subtree under `index` into the spare arena, breadth first so every
+// child block stays contiguous, and makes it the tree.
+static void keep_subtree(const uint32_t index) {
+    MctsNode* dst = tree.spare;
+    memcpy(&dst[0], &tree.nodes[index], sizeof(MctsNode));
+    dst[0].move = MOVE_NONE;
+    size_t used = 1;
+    for (size_t i = 0; i < used; i++) {
+        if (atomic_load_explicit(&dst[i].state, memory_order_relaxed) != MCTS_EXPANDED) continue;
+        memcpy(&dst[used], &tree.nodes[dst[i].first_child], dst[i].child_count * sizeof(MctsNode));
+        dst[i].first_child = (uint32_t)used;
+        used += dst[i].child_count;
+    }
+    tree.spare = tree.nodes;
+    tree.nodes = dst;
+    atomic_store_explicit(&tree.used, used, memory_order_relaxed);
+}
+
+// The position one or two moves below the root, as the game moved on: keep that subtree.
+static bool reuse_tree(const Bitboard* position) {
+    if (!tree.has_root) return false;
+    if (tree.root.key == position->key) return true;
+
+    const MctsNode* root = &tree.nodes[0];
+    if (atomic_load(&root->state) != MCTS_EXPANDED) return false;
+    for (uint32_t i = root->first_child; i < root->first_child + root->child_count; i++) {
+        Bitboard after = MakeMove(tree.nodes[i].move, tree.root);
+        if (after.key == position->key) {
+            keep_subtree(i);
+            tree.root = after;
+            return true;
+        }
+        const MctsNode* child = &tree.nodes[i];
+        if (atomic_load(&child->state) != MCTS_EXPANDED) continue;
+        for (uint32_t j = child->first_child; j < child->first_child + child->child_count; j++) {
+            const Bitboard reply = MakeMove(tree.nodes[j].move, after);
+            if (reply.key == position->key) {
+                keep_subtree(j);
+                tree.root = reply;
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+bool mcts_set_root(const Bitboard* root) {
+    if (!tree.nodes) mcts_set_memory(tree_mb);
+    if (reuse_tree(root)) return true;
+    reset_tree(root);
+    return false;
+}
+
+// --- Threads ---
+
+// Per-thread scratch, allocated once and reused by every search.
+typedef struct {
+    Bitboard root;              // tree root, with this thread's NNUE accumulators attached
+    Bitboard board;             // replayed from `root` on every descent
+    uint32_t path[MAX_PLY + 1];
+    uint64_t keys[MAX_GAME_PLY + MAX_PLY + 1];
+    int root_key_count;         // keys of the game before the root, and the root
+    int key_count;
+    _Atomic uint64_t playouts;  // written only by the owner
+    int seldepth;
+    PawnTable pawns;
+    EvalState eval;
+    NnueAccumulator accumulators[MAX_PLY + 1];
+} MctsThread;
+
+static MctsThread* mcts_threads[MCTS_MAX_THREADS];
+
+typedef struct {
+    const SearchLimits* limits;
+    TimeManager time;
+    uint64_t start_ns;
+    uint64_t last_info_ns;
+    int thread_count;
+} MctsJob;
+
+static bool is_draw(const MctsThread* t) {
+    const Bitboard* b = &t->board;
+    if (b->halfmove_clock >= 100) return true;
+    const int current = t->key_count - 1;
+    const int oldest = current - b->halfmove_clock > 0 ? current - b->halfmove_clock : 0;
+    for (int i = current - 4; i >= oldest; i -= 2) {
+        if (t->keys[i] == b->key) return true;
+    }
+    return false;
+}
+
+// For the side to move, in MCTS_VALUE_ONE units.
+static uint64_t leaf_value(MctsThread* t) {
+    const int cp = evaluate_position(&t->board, &t->eval);
+    return (uint64_t)(MCTS_VALUE_ONE / (1.0 + exp(-cp / MCTS_CP_SCALE)));
+}
+
+// Creates the children of `node`, captures and promotions first since unvisited
+// children are tried in order. False if the arena is full.
+static bool expand(MctsNode* node, const Bitboard* b) {
+    MoveList list;
+    list.count = 0;
+    generate_legal_moves(b, &list);
+    if (list.count == 0) {
+        atomic_store_explicit(&node->state, MCTS_TERMINAL, memory_order_release);
+        return true;
+    }
+
+    const size_t first = atomic_fetch_add_explicit(&tree.used, list.count, memory_order_relaxed);
+    if (first + list.count > tree.capacity) {
+        atomic_store_explicit(&node->state, MCTS_LEAF, memory_order_relaxed);
+        return false;
+    }
+
+    size_t tactical = 0;
+    for (size_t i = 0; i < list.count; i++) {
+        const move16 m = list.moves[i];
+        if (IS_CAPTURE(b, m) || IS_PROMO(m)) {
+            list.moves[i] = list.moves[tactical];
+            list.moves[tactical++] = m;
+        }
+    }
+    for (size_t i = 0; i < list.count; i++) {
+        MctsNode* child = &tree.nodes[first + i];
+        atomic_store_explicit(&child->value, 0, memory_order_relaxed);
+        atomic_store_explicit(&child->visits, 0, memory_order_relaxed);
+        child->first_child = 0;
+        child->child_count = 0;
+        child->move = list.moves[i];
+        atomic_store_explicit(&child->state, MCTS_LEAF, memory_order_relaxed);
+    }
+    node->first_child = (uint32_t)first;
+    node->child_count = (uint16_t)list.count;
+    atomic_store_explicit(&node->state, MCTS_EXPANDED, memory_order_release);
+    return true;
+}
+
+// UCT over the children; an unvisited child is taken at once. Visits include the
+// virtual losses of descents still in flight, which count as lost.
+static uint32_t select_child(const MctsNode* node) {
+    const uint32_t parent_visits = atomic_load_explicit(&node->visits, memory_order_relaxed);
+    const double explore = MCTS_EXPLORATION * sqrt(log((double)parent_visits + 1.0));
+    uint32_t best = node->first_child;
+    double best_score = -1.0;
+    for (uint32_t i = node->first_child; i < node->first_child + node->child_count; i++) {
+        const MctsNode* child = &tree.nodes[i];
+        const uint32_t visits = atomic_load_explicit(&child->visits, memory_order_relaxed);
+        if (visits == 0) return i;
+        const double q = (double)atomic_load_explicit(&child->value, memory_order_relaxed) / MCTS_VALUE_ONE / visits;
+        const double score = q + explore / sqrt((double)visits);
+        if (score > best_score) {
+            best_score = score;
+            best = i;
+        }
+    }
+    return best;
+}
+
+// One descent from the root to a leaf, which is evaluated (or expanded first, on
+// a repeat visit), and the result backed up the path.
+static void playout(MctsThread* t) {
+    t->board = t->root;
+    t->key_count = t->root_key_count;
+    uint32_t index = 0;
+    int ply = 0;
+    uint64_t value;        // for the side to move at the end of the path
+    t->path[0] = 0;
+    atomic_fetch_add_explicit(&tree.nodes[0].visits, MCTS_VIRTUAL_LOSS, memory_order_relaxed);
+
+    while (true) {
+        MctsNode* node = &tree.nodes[index];
+        uint8_t state = atomic_load_explicit(&node->state, memory_order_acquire);
+        if (state == MCTS_TERMINAL) {
+            value = in_check(&t->board) ? 0 : MCTS_VALUE_ONE / 2;
+            break;
+        }
+        if (ply > 0 && is_draw(t)) {
+            value = MCTS_VALUE_ONE / 2;
+            break;
+        }
+        if (ply >= MAX_PLY - 1) {
+            value = leaf_value(t);
+            break;
+        }
+        if (state == MCTS_LEAF) {
+            // Reached before (by this or another descent): give it children. Once the
+            // arena is full the tree stops growing and its leaves keep being evaluated.
+            const bool repeat = atomic_load_explicit(&node->visits, memory_order_relaxed) >=
+                                (MCTS_EXPAND_VISITS - 1) + MCTS_VIRTUAL_LOSS;
+            const bool room = atomic_load_explicit(&tree.used, memory_order_relaxed) < tree.capacity;
+            uint8_t expected = MCTS_LEAF;
+            if ((ply == 0 || repeat) && room &&
+                atomic_compare_exchange_strong_explicit(&node->state, &expected, MCTS_EXPANDING,
+                                                        memory_order_acquire, memory_order_relaxed)) {
+                expand(node, &t->board);
+                state = atomic_load_explicit(&node->state, memory_order_relaxed);
+                if (state == MCTS_TERMINAL) continue;
+            }
+            if (state != MCTS_EXPANDED) {
+                value = leaf_value(t);
+                break;
+            }
+        }
+        if (state == MCTS_EXPANDING) {
+            value = leaf_value(t);
+            break;
+        }
+
+        index = select_child(node);
+        atomic_fetch_add_explicit(&tree.nodes[index].visits, MCTS_VIRTUAL_LOSS, memory_order_relaxed);
+        Undo undo;
+        make_move(&t->board, tree.nodes[index].move, &undo);
+        t->keys[t->key_count++] = t->board.key;
+        t->path[++ply] = index;
+    }
+    if (ply > t->seldepth) t->seldepth = ply;
+
+    // Each node keeps the result of the side that moved into it.
+    for (int i = ply; i >= 0; i--) {
+        MctsNode* node = &tree.nodes[t->path[i]];
+        value = MCTS_VALUE_ONE - value;
+        atomic_fetch_add_explicit(&node->value, value, memory_order_relaxed);
+        atomic_fetch_sub_explicit(&node->visits, MCTS_VIRTUAL_LOSS - 1, memory_order_relaxed);
+    }
+}
+
+// --- Reporting ---
+
+static uint32_t most_visited_child(const MctsNode* node) {
+    uint32_t best = node->first_child, best_visits = 0;
+    for (uint32_t i = node->first_child; i < node->first_child + node->child_count; i++) {
+        const uint32_t visits = atomic_load_explicit(&tree.nodes[i].visits, memory_order_relaxed);
+        if (visits > best_visits) {
+            best_visits = visits;
+            best = i;
+        }
+    }
+    return best;
+}
+
+// Most visited line from the root; returns the length.
+static int principal_variation(move16* pv, int max_length) {
+    int length = 0;
+    const MctsNode* node = &tree.nodes[0];
+    while (length < max_length && atomic_load_explicit(&node->state, memory_order_acquire) == MCTS_EXPANDED) {
+        const uint32_t child = most_visited_child(node);
+        if (atomic_load_explicit(&tree.nodes[child].visits, memory_order_relaxed) == 0) break;
+        pv[length++] = tree.nodes[child].move;
+        node = &tree.nodes[child];
+    }
+    return length;
+}
+
+static uint64_t total_playouts(const MctsJob* job) {
+    uint64_t playouts = 0;
+    for (int i = 0; i < job->thread_count; i++) {
+        playouts += atomic_load_explicit(&mcts_threads[i]->playouts, memory_order_relaxed);
+    }
+    return playouts;
+}
+
+// Fills the result from the tree: best move, its win rate as centipawns, the PV.
+static void collect_result(const MctsJob* job, SearchResult* result) {
+    result->pv_length = principal_variation(result->pv, MAX_PLY);
+    result->depth = result->pv_length;
+    result->nodes = total_playouts(job);
+    result->time_ns = time_now_ns() - job->start_ns;
+    for (int i = 0; i < job->thread_count; i++) {
+        if (mcts_threads[i]->seldepth > result->seldepth) result->seldepth = mcts_threads[i]->seldepth;
+    }
+    if (result->pv_length == 0) return;
+
+    result->best_move = result->pv[0];
+    const MctsNode* best = &tree.nodes[most_visited_child(&tree.nodes[0])];
+    const uint32_t visits = atomic_load_explicit(&best->visits, memory_order_relaxed);
+    double q = (double)atomic_load_explicit(&best->value, memory_order_relaxed) / MCTS_VALUE_ONE / visits;
+    if (q < 0.001) q = 0.001;
+    if (q > 0.999) q = 0.999;
+    result->score = (int)(-MCTS_CP_SCALE * log(1.0 / q - 1.0));
+}
+
+static void print_info(const SearchResult* r) {
+    char score[SCORE_STR_LEN], move[6];
+    format_score(r->score, score, sizeof(score));
+    const uint64_t ms = r->time_ns / 1000000ULL;
+    const uint64_t nps = r->time_ns ? r->nodes * 1000000000ULL / r->time_ns : 0;
+    printf("info depth %d seldepth %d score %s nodes %llu nps %llu time %llu pv", r->depth, r->seldepth, score,
+           (unsigned long long)r->nodes, (unsigned long long)nps, (unsigned long long)ms);
+    for (int i = 0; i < r->pv_length; i++) {
+        move_to_string(r->pv[i], move);
+        printf(" %s", move);
+    }
+    printf("\n");
+    fflush(stdout);
+}
+
+// Main thread only. Helpers just follow SEARCH_STOP.
+static void check_limits(MctsJob* job) {
+    const SearchLimits* limits = job->limits;
+    const uint64_t now = time_now_ns();
+    if (atomic_load_explicit(&SEARCH_PONDER, memory_order_relaxed)) {
+        job->start_ns = now;
+        return;
+    }
+    bool stop = false;
+    if (limits->nodes && total_playouts(job) >= limits->nodes) stop = true;
+    // No iterations to rescale by: the soft deadline stays at the optimum.
+    if (job->time.active && now - job->start_ns >= job->time.soft_ns) stop = true;
+    if (limits->depth > 0) {
+        move16 pv[MAX_PLY];
+        if (principal_variation(pv, limits->depth) >= limits->depth) stop = true;
+    }
+    if (stop) atomic_store_explicit(&SEARCH_STOP, true, memory_order_relaxed);
+
+    if (!limits->quiet && now - job->last_info_ns >= MCTS_INFO_NS) {
+        job->last_info_ns = now;
+        SearchResult result = {0};
+        collect_result(job, &result);
+        print_info(&result);
+    }
+}
+
+static void mcts_worker(void* context, const size_t index, int worker) {
+    (void)worker;
+    MctsJob* job = context;
+    MctsThread* t = mcts_threads[index];
+    while (!atomic_load_explicit(&SEARCH_STOP, memory_order_relaxed)) {
+        playout(t);
+        const uint64_t playouts = atomic_load_explicit(&t->playouts, memory_order_relaxed) + 1;
+        atomic_store_explicit(&t->playouts, playouts, memory_order_relaxed);
+        if (index == 0 && (playouts & (MCTS_CHECK_PLAYOUTS - 1)) == 0) check_limits(job);
+    }
+}
+
+void mcts_search(const Bitboard* root, const uint64_t* history, int history_count, const SearchLimits* limits,
+                 SearchResult* result) {
+    int thread_count = limits->threads > 0 ? limits->threads : 1;
+    if (thread_count > MCTS_MAX_THREADS) thread_count = MCTS_MAX_THREADS;
+    mcts_set_root(root);
+    if (history_count > MAX_GAME_PLY) {
+        history += history_count - MAX_GAME_PLY;
+        history_count = MAX_GAME_PLY;
+    }
+
+    for (int i = 0; i < thread_count; i++) {
+        if (!mcts_threads[i]) {
+            // Zeroed: an all-zero pawn entry is the valid entry for pawn_key 0.
+            mcts_threads[i] = calloc(1, sizeof(MctsThread));
+            if (!mcts_threads[i]) {
+                fprintf(stderr, "Failed to allocate the search stack\n");
+                exit(EXIT_FAILURE);
+            }
+            mcts_threads[i]->eval.pawns = &mcts_threads[i]->pawns;
+        }
+        MctsThread* t = mcts_threads[i];
+        t->root = *root;
+        t->root.nnue = NULL;
+        if (nnue_enabled()) nnue_attach(&t->root, t->accumulators);
+        if (history_count > 0) memcpy(t->keys, history, (size_t)history_count * sizeof(uint64_t));
+        t->keys[history_count] = root->key;
+        t->root_key_count = history_count + 1;
+        atomic_store_explicit(&t->playouts, 0, memory_order_relaxed);
+        t->seldepth = 0;
+    }
+
+    memset(result, 0, sizeof(*result));
+    MoveList root_moves;
+    root_moves.count = 0;
+    generate_legal_moves(root, &root_moves);
+    if (root_moves.count == 0) {
+        result->score = in_check(root) ? -VALUE_MATE : VALUE_DRAW;
+        atomic_store(&SEARCH_STOP, false);
+        return;
+    }
+    result->best_move = root_moves.moves[0];
+
+    MctsJob job = {limits, {0}, time_now_ns(), 0, thread_count};
+    job.last_info_ns = job.start_ns;
+    time_init(&job.time, limits->movetime_ms, limits->time_ms, limits->inc_ms, limits->movestogo,
+              search_get_param("move_overhead"), (int)root_moves.count);
+    threadpool_run(thread_count, (size_t)thread_count, mcts_worker, &job);
+
+    atomic_store(&SEARCH_STOP, false);
+    const move16 fallback = result->best_move;
+    collect_result(&job, result);
+    if (!result->best_move) result->best_move = fallback;
+    if (!limits->quiet) print_info(result);
+}
@@ -0,0 +1,66 @@
+//
+// Created by lenovo on 10/18/2026.
+//
+
+#ifndef MCTS_H
+#define MCTS_H
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdatomic.h>
+#include "bitboard.h"
+#include "move.h"
+#include "search.h"
+
+// === Tree ===
+// Nodes live in one preallocated arena and hold only a move and statistics: a
+// node's children are a contiguous block found by index, and boards are rebuilt
+// by replaying the moves from the root on every descent. Threads share the tree:
+// visits are atomic and a descent adds MCTS_VIRTUAL_LOSS visits along its path
+// before its result arrives, steering the other threads elsewhere.
+#define MCTS_DEFAULT_MB     64          // both arenas together, see mcts_set_memory
+#define MCTS_VALUE_ONE      (1U << 16)  // fixed-point value of a win
+#define MCTS_VIRTUAL_LOSS   3
+#define MCTS_EXPAND_VISITS  2           // a leaf gets children on its second visit
+#define MCTS_MAX_THREADS    MAX_SEARCH_THREADS
+
+enum {
+    MCTS_LEAF,
+    MCTS_EXPANDING,         // one thread is writing the children
+    MCTS_EXPANDED,
+    MCTS_TERMINAL,          // checkmate or stalemate
+};
+
+typedef struct {
+    _Atomic uint64_t value;     // results for the side that moved into this node, MCTS_VALUE_ONE per win
+    _Atomic uint32_t visits;    // completed descents plus virtual losses in flight
+    uint32_t first_child;       // arena index, valid once state is MCTS_EXPANDED
+    uint16_t child_count;
+    move16 move;                // move leading here, MOVE_NONE at the root
+    _Atomic uint8_t state;
+} MctsNode;
+
+// Monte Carlo tree search of `root` with UCT selection and a static-eval leaf
+// value, on `limits->threads` threads. Stops on the node (playout) limit, the
+// clock, a PV `limits->depth` long, or SEARCH_STOP; a full arena only stops the
+// tree from growing. If `root` is the current tree root or one or two moves
+// below it, the matching subtree is kept and searched further. The best move is
+// the most visited one; result->nodes counts playouts.
+void mcts_search(const Bitboard* root, const uint64_t* history, int history_count, const SearchLimits* limits,
+                 SearchResult* result);
+
+// Resizes the arenas (`mb` for both) and empties the tree. Not thread-safe: call
+// while no search is running.
+void mcts_set_memory(size_t mb);
+void mcts_clear(void);
+
+// Makes `root` the tree root, keeping its subtree if it is the current root or one
+// or two moves below it (true), otherwise emptying the tree. mcts_search does this
+// itself.
+bool mcts_set_root(const Bitboard* root);
+
+// Nodes in the tree, the root included.
+size_t mcts_tree_nodes(void);
+
+#endif //MCTS_H
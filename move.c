@@ -9,223 +9,286 @@
 #include "constants.h"
 #include "bitboard.h"
 #include "move.h"
-
-typedef struct {
-    uint64_t from;              // bitboard representation of from square
-    uint64_t to;                // bitboard representation of to square
-    uint8_t from_square;        // square index (0-63)
-    uint8_t to_square;          // square index (0-63)
-    uint8_t piece;              // piece type being moved
-    uint8_t captured;           // captured piece (if any)
-    uint8_t promotion;          // promotion piece (if any)
-    uint8_t flags;              // move flags
-
-    // Store previous board state for undo
-    uint64_t prev_en_passant_target;
-    uint8_t prev_en_passant_rank;
-    uint8_t prev_en_passant_file;
-    uint8_t prev_castling_rights;
-    uint16_t prev_halfmove_clock;
-} Move;
+#include "zobrist.h"
+#include "attacks.h"
+#include "eval.h"
+#include "nnue.h"
+#include "utils.h"
 
 // Optimized occupancy update functions
-static inline void update_occupancy_remove(Bitboard *b, uint64_t sq, uint8_t piece) {
-    b->all_occupancy ^= sq;
-    if (IS_BLACK(piece)) {
-        b->black_occupancy ^= sq;
+static inline void update_occupancy_remove(Bitboard *b, uint64_t bit, int index) {
+    b->all_occupancy ^= bit;
+    if (INDEX_SIDE(index)) {
+        b->black_occupancy ^= bit;
     } else {
-        b->white_occupancy ^= sq;
+        b->white_occupancy ^= bit;
     }
 }
 
-static inline void update_occupancy_add(Bitboard *b, uint64_t sq, uint8_t piece) {
-    b->all_occupancy |= sq;
-    if (IS_BLACK(piece)) {
-        b->black_occupancy |= sq;
+static inline void update_occupancy_add(Bitboard *b, uint64_t bit, int index) {
+    b->all_occupancy |= bit;
+    if (INDEX_SIDE(index)) {
+        b->black_occupancy |= bit;
     } else {
-        b->white_occupancy |= sq;
+        b->white_occupancy |= bit;
     }
 }
 
-// Precomputed castling masks for faster updates
-static const uint8_t CASTLE_KING_LOST[2] = {
-    ~(CASTLE_WHITE_K | CASTLE_WHITE_Q),
-    ~(CASTLE_BLACK_K | CASTLE_BLACK_Q)
-};
-
-static uint8_t CASTLE_ROOK_LOST[64] = {
+// Castling rights that survive a move touching each square (king or rook moving
+// away, or a rook being captured on its home square).
+static const uint8_t CASTLE_RIGHTS_MASK[64] = {
     [0 ... 63] = 0xFF,
-    [0] = ~CASTLE_WHITE_Q,
-    [7] = ~CASTLE_WHITE_K,
-    [56] = ~CASTLE_BLACK_Q,
-    [63] = ~CASTLE_BLACK_K,
+    [0]  = (uint8_t)~CASTLE_WHITE_Q,
+    [4]  = (uint8_t)~CASTLE_WHITE,
+    [7]  = (uint8_t)~CASTLE_WHITE_K,
+    [56] = (uint8_t)~CASTLE_BLACK_Q,
+    [60] = (uint8_t)~CASTLE_BLACK,
+    [63] = (uint8_t)~CASTLE_BLACK_K,
 };
 
-// __attribute__((constructor))
-// static void init_castle_lookup() {
-//     for (int i = 0; i < 64; i++) {
-//         if (i != 0 && i != 7 && i != 56 && i != 63) {
-//             CASTLE_ROOK_LOST[i] = 0xFF;
-//         }
-//     }
-// }
-
 // --- Internal Helpers ---
 
-static inline void remove_piece(Bitboard* b, uint64_t sq, uint8_t piece) {
-    update_occupancy_remove(b, sq, piece);
-    b->pieces[PIECE_INDEX(piece)] ^= sq;
-}
+static inline void remove_piece(Bitboard* b, int sq, int index) {
+    const uint64_t bit = 1ULL << sq;
+    update_occupancy_remove(b, bit, index);
+    b->pieces[index] ^= bit;
 
-static inline void add_piece(Bitboard* b, uint64_t sq, uint8_t piece) {
-    update_occupancy_add(b, sq, piece);
-    b->pieces[PIECE_INDEX(piece)] |= sq;
+    b->key ^= ZOBRIST_PIECES[index][sq];
+    if (INDEX_TYPE(index) == INDEX_PAWN) b->pawn_key ^= ZOBRIST_PIECES[index][sq];
+    b->material_key ^= ZOBRIST_MATERIAL[index][popcount(b->pieces[index])];
+
+    b->psq_mg -= PSQ_MG[index][sq];
+    b->psq_eg -= PSQ_EG[index][sq];
+    b->phase -= PHASE_WEIGHTS[INDEX_TYPE(index)];
+    if (b->nnue) nnue_record(b->nnue, index, sq, -1);
 }
 
-static void apply_castling(Bitboard* b, const Move* m) {
-    uint64_t rook_from, rook_to;
-    uint8_t rook_piece = MOVING ? PIECE_BROOK : PIECE_WROOK;
+static inline void add_piece(Bitboard* b, int sq, int index) {
+    const uint64_t bit = 1ULL << sq;
+    b->material_key ^= ZOBRIST_MATERIAL[index][popcount(b->pieces[index])];
+    update_occupancy_add(b, bit, index);
+    b->pieces[index] |= bit;
 
-    switch (m->to_square) {
-        case CASTLE_WK_TO: rook_from = 1ULL << 7;  rook_to = 1ULL << 5;  break;
-        case CASTLE_WQ_TO: rook_from = 1ULL << 0;  rook_to = 1ULL << 3;  break;
-        case CASTLE_BK_TO: rook_from = 1ULL << 63; rook_to = 1ULL << 61; break;
-        case CASTLE_BQ_TO: rook_from = 1ULL << 56; rook_to = 1ULL << 59; break;
-        default:
-            fprintf(stderr, "Invalid castling target: %u\n", m->to_square);
-            exit(EXIT_FAILURE);
-    }
+    b->key ^= ZOBRIST_PIECES[index][sq];
+    if (INDEX_TYPE(index) == INDEX_PAWN) b->pawn_key ^= ZOBRIST_PIECES[index][sq];
 
-    remove_piece(b, rook_from, rook_piece);
-    add_piece(b, rook_to, rook_piece);
-    b->pieces[PIECE_INDEX(rook_piece)] ^= (rook_from | rook_to);
+    b->psq_mg += PSQ_MG[index][sq];
+    b->psq_eg += PSQ_EG[index][sq];
+    b->phase += PHASE_WEIGHTS[INDEX_TYPE(index)];
+    if (b->nnue) nnue_record(b->nnue, index, sq, +1);
 }
 
-static void undo_castling(Bitboard* b, const Move* m) {
-    uint64_t rook_from, rook_to;
-    uint8_t rook_piece = MOVING ? PIECE_WROOK : PIECE_BROOK;
+static inline void set_castling_rights(Bitboard* b, uint8_t rights) {
+    b->key ^= ZOBRIST_CASTLING[b->castling_rights] ^ ZOBRIST_CASTLING[rights];
+    b->castling_rights = rights;
+}
 
-    switch (m->to_square) {
-        case CASTLE_WK_TO: rook_from = 1ULL << 5;  rook_to = 1ULL << 7;  break;
-        case CASTLE_WQ_TO: rook_from = 1ULL << 3;  rook_to = 1ULL << 0;  break;
-        case CASTLE_BK_TO: rook_from = 1ULL << 61; rook_to = 1ULL << 63; break;
-        case CASTLE_BQ_TO: rook_from = 1ULL << 59; rook_to = 1ULL << 56; break;
+static inline void castling_rook_squares(int king_to, int* rook_from, int* rook_to) {
+    switch (king_to) {
+        case CASTLE_WK_TO: *rook_from = 7;  *rook_to = 5;  break;
+        case CASTLE_WQ_TO: *rook_from = 0;  *rook_to = 3;  break;
+        case CASTLE_BK_TO: *rook_from = 63; *rook_to = 61; break;
+        case CASTLE_BQ_TO: *rook_from = 56; *rook_to = 59; break;
         default:
-            fprintf(stderr, "Invalid castling target: %u\n", m->to_square);
+            fprintf(stderr, "Invalid castling target: %d\n", king_to);
             exit(EXIT_FAILURE);
     }
-
-    remove_piece(b, rook_from, rook_piece);
-    add_piece(b, rook_to, rook_piece);
-    b->pieces[PIECE_INDEX(rook_piece)] ^= (rook_from | rook_to);
 }
 
-static void apply_en_passant(Bitboard* b, const Move* m) {
-    uint8_t ep_rank = MOVING ? (m->to_square >> 3) - 1 : (m->to_square >> 3) + 1;
-    uint8_t ep_file = m->to_square & 7;
-    uint64_t ep_bit = 1ULL << (ep_rank * 8 + ep_file);
-    remove_piece(b, ep_bit, m->captured);
+static void apply_castling(Bitboard* b, int king_to) {
+    int rook_from, rook_to;
+    const int rook = INDEX_OF(MOVING, INDEX_ROOK);
+    castling_rook_squares(king_to, &rook_from, &rook_to);
+    remove_piece(b, rook_from, rook);
+    add_piece(b, rook_to, rook);
 }
 
-static void undo_en_passant(Bitboard* b, const Move* m) {
-    uint8_t ep_rank = MOVING ? (m->to_square >> 3) - 1 : (m->to_square >> 3) + 1;
-    uint8_t ep_file = m->to_square & 7;
-    uint64_t ep_bit = 1ULL << (ep_rank * 8 + ep_file);
-    add_piece(b, ep_bit, m->captured);
+static void undo_castling(Bitboard* b, int king_to) {
+    int rook_from, rook_to;
+    const int rook = INDEX_OF(MOVING, INDEX_ROOK);
+    castling_rook_squares(king_to, &rook_from, &rook_to);
+    remove_piece(b, rook_to, rook);
+    add_piece(b, rook_from, rook);
 }
 
-static void update_en_passant_target(Bitboard* b, const Move* m) {
+static inline void clear_en_passant_target(Bitboard* b) {
+    if (b->en_passant_target) b->key ^= ZOBRIST_EN_PASSANT[b->en_passant_file];
     b->en_passant_target = 0;
     b->en_passant_file = 0xFF;
     b->en_passant_rank = 0xFF;
+}
 
-    if ((m->piece & 0x0F) == PIECE_PAWN) {
-        int from_rank = m->from_square >> 3;
-        int to_rank   = m->to_square >> 3;
-        int file      = m->to_square & 7;
-
-        if (IS_WHITE_TURN && from_rank == 1 && to_rank == 3) {
-            int ep_rank = 2;
-            b->en_passant_target = 1ULL << (ep_rank * 8 + file);
-            b->en_passant_rank = ep_rank;
-            b->en_passant_file = file;
-        } else if (IS_BLACK_TURN && from_rank == 6 && to_rank == 4) {
-            int ep_rank = 5;
-            b->en_passant_target = 1ULL << (ep_rank * 8 + file);
-            b->en_passant_rank = ep_rank;
-            b->en_passant_file = file;
+static inline void update_en_passant_target(Bitboard* b, int index, int from, int to) {
+    clear_en_passant_target(b);
+
+    // Double pawn push: the target is the square that was jumped over. It is only
+    // recorded when an enemy pawn can actually capture there, so positions that
+    // differ by a useless target share a key.
+    if (INDEX_TYPE(index) == INDEX_PAWN && (from ^ to) == 16) {
+        const int ep_square = (from + to) >> 1;
+        const uint64_t ep_bit = 1ULL << ep_square;
+        const int enemy_pawns = INDEX_OF(OPPONENT, INDEX_PAWN);
+        if (PAWN_ATTACKS[INDEX_SIDE(index)][ep_square] & b->pieces[enemy_pawns]) {
+            b->en_passant_target = ep_bit;
+            b->en_passant_rank = ep_square >> 3;
+            b->en_passant_file = ep_square & 7;
+            b->key ^= ZOBRIST_EN_PASSANT[b->en_passant_file];
         }
     }
 }
 
-
-static void update_castling_rights(Bitboard* b, const Move* m) {
-    if ((m->piece & 0x0F) == PIECE_KING) {
-        b->castling_rights &= CASTLE_KING_LOST[MOVING];
-    } else if ((m->piece & 0x0F) == PIECE_ROOK) {
-        b->castling_rights &= CASTLE_ROOK_LOST[m->from_square];
+// --- make_move & unmake_move ---
+
+void make_move(Bitboard* b, const move16 m, Undo* u) {
+    const int from = MOVE_FROM(m);
+    const int to = MOVE_TO(m);
+    const int flag = MOVE_FLAG(m);
+    const int piece = piece_on(b, from);
+
+    u->en_passant_target = b->en_passant_target;
+    u->en_passant_rank = b->en_passant_rank;
+    u->en_passant_file = b->en_passant_file;
+    u->castling_rights = b->castling_rights;
+    u->halfmove_clock = b->halfmove_clock;
+    u->captured = INDEX_EMPTY;
+    if (b->nnue) nnue_push(b);
+
+    if (flag == MOVE_FLAG_ENPASSANT) {
+        u->captured = INDEX_OF(OPPONENT, INDEX_PAWN);
+        remove_piece(b, to ^ 8, u->captured);
+    } else if (b->all_occupancy & (1ULL << to)) {
+        u->captured = piece_on(b, to);
+        remove_piece(b, to, u->captured);
     }
 
-    if (IS_CAPTURE(*m)) {
-        b->castling_rights &= CASTLE_ROOK_LOST[m->to_square];
-    }
+    remove_piece(b, from, piece);
+    add_piece(b, to, flag == MOVE_FLAG_PROMOTION ? INDEX_OF(MOVING, MOVE_PROMO(m)) : piece);
+
+    if (flag == MOVE_FLAG_CASTLE) apply_castling(b, to);
+
+    const uint8_t rights = b->castling_rights & CASTLE_RIGHTS_MASK[from] & CASTLE_RIGHTS_MASK[to];
+    if (rights != b->castling_rights) set_castling_rights(b, rights);
+    update_en_passant_target(b, piece, from, to);
+
+    b->halfmove_clock = (INDEX_TYPE(piece) == INDEX_PAWN || u->captured != INDEX_EMPTY) ? 0 : b->halfmove_clock + 1;
+    if (b->to_move == BLACK) b->fullmove_number++;
+    b->to_move ^= 1;
+    b->key ^= ZOBRIST_SIDE;
+
+#ifdef CHESS_DEBUG_CHECKS
+    verify_keys(b, "make_move");
+    verify_eval(b, "make_move");
+#endif
 }
 
-// --- MakeMove & UndoMove ---
+void unmake_move(Bitboard* b, const move16 m, const Undo* u) {
+    const int from = MOVE_FROM(m);
+    const int to = MOVE_TO(m);
+    const int flag = MOVE_FLAG(m);
 
-Bitboard MakeMove(Move m, Bitboard b) {
-    Bitboard mb = b;
+    // The parent's accumulator is still on the stack below: detach while the pieces
+    // move back so nothing is recorded, then pop.
+    NnueAccumulator* nnue = b->nnue;
+    b->nnue = NULL;
 
-    remove_piece(&mb, m.from, m.piece);
+    b->to_move ^= 1;
+    b->key ^= ZOBRIST_SIDE;
+    if (b->to_move == BLACK) b->fullmove_number--;
 
-    if (IS_PROMO(m)) {
-        add_piece(&mb, m.to, m.promotion);
-    } else {
-        add_piece(&mb, m.to, m.piece);
+    const int moved = piece_on(b, to);
+    if (flag == MOVE_FLAG_CASTLE) undo_castling(b, to);
+
+    remove_piece(b, to, moved);
+    add_piece(b, from, flag == MOVE_FLAG_PROMOTION ? INDEX_OF(MOVING, INDEX_PAWN) : moved);
+
+    if (u->captured != INDEX_EMPTY) {
+        add_piece(b, flag == MOVE_FLAG_ENPASSANT ? to ^ 8 : to, u->captured);
     }
 
-    if (IS_CAPTURE(m) && !IS_EP(m)) {
-        remove_piece(&mb, m.to, m.captured);
+    clear_en_passant_target(b);
+    if (u->en_passant_target) {
+        b->en_passant_target = u->en_passant_target;
+        b->en_passant_rank = u->en_passant_rank;
+        b->en_passant_file = u->en_passant_file;
+        b->key ^= ZOBRIST_EN_PASSANT[b->en_passant_file];
     }
+    if (u->castling_rights != b->castling_rights) set_castling_rights(b, u->castling_rights);
+    b->halfmove_clock = u->halfmove_clock;
+    b->nnue = nnue ? nnue - 1 : NULL;
+
+#ifdef CHESS_DEBUG_CHECKS
+    verify_keys(b, "unmake_move");
+    verify_eval(b, "unmake_move");
+#endif
+}
+
+// --- Null move ---
+
+// Passes the turn: only the side to move and the en passant target change. The
+// halfmove clock restarts so repetition checks never look back across the pass.
+// No piece moves, so the NNUE accumulator is shared with the parent.
+void make_null_move(Bitboard* b, Undo* u) {
+    u->en_passant_target = b->en_passant_target;
+    u->en_passant_rank = b->en_passant_rank;
+    u->en_passant_file = b->en_passant_file;
+    u->castling_rights = b->castling_rights;
+    u->halfmove_clock = b->halfmove_clock;
+    u->captured = INDEX_EMPTY;
+
+    clear_en_passant_target(b);
+    b->halfmove_clock = 0;
+    if (b->to_move == BLACK) b->fullmove_number++;
+    b->to_move ^= 1;
+    b->key ^= ZOBRIST_SIDE;
+
+#ifdef CHESS_DEBUG_CHECKS
+    verify_keys(b, "make_null_move");
+#endif
+}
 
-    if (IS_EP(m)) apply_en_passant(&mb, &m);
-    if (IS_CASTLE(m)) apply_castling(&mb, &m);
+void unmake_null_move(Bitboard* b, const Undo* u) {
+    b->to_move ^= 1;
+    b->key ^= ZOBRIST_SIDE;
+    if (b->to_move == BLACK) b->fullmove_number--;
 
-    update_en_passant_target(&mb, &m);
-    update_castling_rights(&mb, &m);
+    if (u->en_passant_target) {
+        b->en_passant_target = u->en_passant_target;
+        b->en_passant_rank = u->en_passant_rank;
+        b->en_passant_file = u->en_passant_file;
+        b->key ^= ZOBRIST_EN_PASSANT[b->en_passant_file];
+    }
+    b->halfmove_clock = u->halfmove_clock;
+
+#ifdef CHESS_DEBUG_CHECKS
+    verify_keys(b, "unmake_null_move");
+#endif
+}
 
-    mb.halfmove_clock = ((m.piece & 0x0F) == PIECE_PAWN || IS_CAPTURE(m)) ? 0 : mb.halfmove_clock + 1;
-    if (mb.to_move == 1) mb.fullmove_number++;
-    mb.to_move ^= 1;
+// --- Copy-make ---
 
-    return mb;
+Bitboard MakeMove(const move16 m, Bitboard board) {
+    // The copy must not push onto the caller's NNUE accumulator stack.
+    board.nnue = NULL;
+    Undo u;
+    make_move(&board, m, &u);
+    return board;
 }
 
-Bitboard UndoMove(Move m, Bitboard b) {
-    Bitboard mb = b;
-    mb.to_move ^= 1;
-    if (mb.to_move == 1) mb.fullmove_number--;
+// --- Notation ---
 
-    if (IS_CASTLE(m)) undo_castling(&mb, &m);
+void move_to_string(const move16 m, char* out) {
+    static const char promo_chars[4] = {'n', 'b', 'r', 'q'};
+    const int from = MOVE_FROM(m);
+    const int to = MOVE_TO(m);
 
+    out[0] = (char)('a' + (from & 7));
+    out[1] = (char)('1' + (from >> 3));
+    out[2] = (char)('a' + (to & 7));
+    out[3] = (char)('1' + (to >> 3));
     if (IS_PROMO(m)) {
-        remove_piece(&mb, m.to, m.promotion);
-        add_piece(&mb, m.from, m.piece);
+        out[4] = promo_chars[MOVE_PROMO(m) - PIECE_KNIGHT];
+        out[5] = '\0';
     } else {
-        remove_piece(&mb, m.to, m.piece);
-        add_piece(&mb, m.from, m.piece);
-    }
-
-    if (IS_CAPTURE(m)) {
-        if (IS_EP(m)) undo_en_passant(&mb, &m);
-        else add_piece(&mb, m.to, m.captured);
+        out[4] = '\0';
     }
-
-    mb.en_passant_target = m.prev_en_passant_target;
-    mb.en_passant_rank = m.prev_en_passant_rank;
-    mb.en_passant_file = m.prev_en_passant_file;
-    mb.castling_rights = m.prev_castling_rights;
-    mb.halfmove_clock = m.prev_halfmove_clock;
-
-    return mb;
-}
\ No newline at end of file
+}
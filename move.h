@@ -5,36 +5,72 @@
 #ifndef MOVE_H
 #define MOVE_H
 
+#include <stdint.h>
+#include "constants.h"
+#include "bitboard.h"
+
+// Packed move, 16 bits:
+//   bits  0-5   from square (0-63)
+//   bits  6-11  to square (0-63)
+//   bits 12-13  promotion piece type minus PIECE_KNIGHT (N, B, R, Q)
+//   bits 14-15  move flag
+// Captures are not encoded, they are read off the board when the move is made.
+// Castling is encoded as the king move (e1g1, e1c1, e8g8, e8c8).
+typedef uint16_t move16;
+
+#define MOVE_NONE 0
+
+#define MOVE_FLAG_NORMAL     0
+#define MOVE_FLAG_PROMOTION  1
+#define MOVE_FLAG_ENPASSANT  2
+#define MOVE_FLAG_CASTLE     3
+
+#define MOVE_MAKE(from, to)              ((move16)((from) | ((to) << 6)))
+#define MOVE_MAKE_FLAG(from, to, flag)   ((move16)((from) | ((to) << 6) | ((flag) << 14)))
+#define MOVE_MAKE_PROMO(from, to, type)  ((move16)((from) | ((to) << 6) | (((type) - PIECE_KNIGHT) << 12) | \
+                                                   (MOVE_FLAG_PROMOTION << 14)))
+
+#define MOVE_FROM(m)   ((m) & 0x3F)
+#define MOVE_TO(m)     (((m) >> 6) & 0x3F)
+#define MOVE_PROMO(m)  ((((m) >> 12) & 0x3) + PIECE_KNIGHT)   // promotion piece type
+#define MOVE_FLAG(m)   ((m) >> 14)
+
+// Irreversible state saved by make_move and restored by unmake_move. Callers keep
+// one per ply (e.g. `Undo undo[MAX_PLY]` next to the search stack), which makes
+// up the undo stack.
 typedef struct {
-    uint64_t from;              // bitboard representation of from square
-    uint64_t to;                // bitboard representation of to square
-    uint8_t from_square;        // square index (0-63)
-    uint8_t to_square;          // square index (0-63)
-    uint8_t piece;              // piece type being moved
-    uint8_t captured;           // captured piece (if any)
-    uint8_t promotion;          // promotion piece (if any)
-    uint8_t flags;              // move flags
-
-    // Store previous board state for undo
-    uint64_t prev_en_passant_target;
-    uint8_t prev_en_passant_rank;
-    uint8_t prev_en_passant_file;
-    uint8_t prev_castling_rights;
-    uint16_t prev_halfmove_clock;
-} Move;
-
-Bitboard MakeMove(Move m, Bitboard board);
-Bitboard UndoMove(Move m, Bitboard board);
+    uint64_t en_passant_target;
+    uint8_t en_passant_rank;
+    uint8_t en_passant_file;
+    uint8_t castling_rights;
+    int8_t captured;            // index of the captured piece, INDEX_EMPTY if none
+    uint16_t halfmove_clock;
+} Undo;
+
+// In-place make/unmake. `m` must be pseudo-legal in `b`.
+void make_move(Bitboard* b, move16 m, Undo* u);
+void unmake_move(Bitboard* b, move16 m, const Undo* u);
+
+// Passes the turn, for null-move pruning. Never call in check.
+void make_null_move(Bitboard* b, Undo* u);
+void unmake_null_move(Bitboard* b, const Undo* u);
+
+// Long algebraic (UCI) notation, e.g. "e2e4", "e7e8q". `out` needs 6 bytes.
+void move_to_string(move16 m, char* out);
+
+// Copy-make: returns the position after `m`, leaving `board` untouched. The copy has
+// no NNUE accumulator (nnue is NULL), so it never writes to a search stack.
+Bitboard MakeMove(move16 m, Bitboard board);
 
 #define IS_BLACK(piece) ((piece) & 0x10)
 #define IS_WHITE(piece) (!IS_BLACK(piece))
 #define PIECE_INDEX(p) index_from_piece(p)
-#define SQUARE_FROM(m) (m.from)
-#define SQUARE_TO(m)   (m.to)
-#define IS_PROMO(m)    ((m.flags) & MOVE_FLAG_PROMOTION)
-#define IS_CAPTURE(m)  ((m.flags) & MOVE_FLAG_CAPTURE)
-#define IS_EP(m)       ((m.flags) & MOVE_FLAG_ENPASSANT)
-#define IS_CASTLE(m)   ((m.flags) & MOVE_FLAG_CASTLE)
+#define SQUARE_FROM(m) MOVE_FROM(m)
+#define SQUARE_TO(m)   MOVE_TO(m)
+#define IS_PROMO(m)    (MOVE_FLAG(m) == MOVE_FLAG_PROMOTION)
+#define IS_EP(m)       (MOVE_FLAG(m) == MOVE_FLAG_ENPASSANT)
+#define IS_CASTLE(m)   (MOVE_FLAG(m) == MOVE_FLAG_CASTLE)
+#define IS_CAPTURE(b, m) (IS_EP(m) || ((b)->all_occupancy & (1ULL << MOVE_TO(m))))
 
 #define CASTLE_WK_TO 6   // g1
 #define CASTLE_WQ_TO 2   // c1
@@ -46,13 +82,4 @@ Bitboard UndoMove(Move m, Bitboard board);
 #define IS_WHITE_TURN (!b->to_move)
 #define IS_BLACK_TURN  (b->to_move)
 
-#ifndef
-#define WHITE false
-#endif
-
-#ifndef
-#define BLACK true
-#endif
-
-
 #endif //MOVE_H
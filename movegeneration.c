@@ -7,54 +7,345 @@
 #include <stdbool.h>
 #include <ctype.h>
 #include "constants.h"
+#include "bitboard.h"
+#include "move.h"
+#include "movegeneration.h"
+#include "attacks.h"
+#include "utils.h"
+
+// --- Attack queries ---
+
+static inline bool square_attacked_through(const Bitboard* b, const int sq, const bool by_side, const uint64_t occupancy) {
+    const uint64_t* p = &b->pieces[INDEX_OF(by_side, INDEX_PAWN)];
+
+    // A pawn of `by_side` attacks `sq` iff a pawn of the other colour on `sq` would attack it back.
+    if (PAWN_ATTACKS[!by_side][sq] & p[INDEX_PAWN]) return true;
+    if (KNIGHT_ATTACKS[sq] & p[INDEX_KNIGHT]) return true;
+    if (KING_ATTACKS[sq] & p[INDEX_KING]) return true;
+    if (bishop_attacks(sq, occupancy) & (p[INDEX_BISHOP] | p[INDEX_QUEEN])) return true;
+    if (rook_attacks(sq, occupancy) & (p[INDEX_ROOK] | p[INDEX_QUEEN])) return true;
+    return false;
+}
+
+bool is_square_attacked(const Bitboard* b, const int sq, const bool by_side) {
+    return square_attacked_through(b, sq, by_side, b->all_occupancy);
+}
+
+uint64_t attackers_to(const Bitboard* b, const int sq, const uint64_t occupancy) {
+    const uint64_t* p = b->pieces;
+    return (PAWN_ATTACKS[BLACK][sq] & p[INDEX_WPAWN])
+         | (PAWN_ATTACKS[WHITE][sq] & p[INDEX_BPAWN])
+         | (KNIGHT_ATTACKS[sq] & (p[INDEX_WKNIGHT] | p[INDEX_BKNIGHT]))
+         | (KING_ATTACKS[sq] & (p[INDEX_WKING] | p[INDEX_BKING]))
+         | (bishop_attacks(sq, occupancy) & (p[INDEX_WBISHOP] | p[INDEX_BBISHOP] | p[INDEX_WQUEEN] | p[INDEX_BQUEEN]))
+         | (rook_attacks(sq, occupancy) & (p[INDEX_WROOK] | p[INDEX_BROOK] | p[INDEX_WQUEEN] | p[INDEX_BQUEEN]));
+}
+
+bool in_check(const Bitboard* b) {
+    return is_square_attacked(b, lsb(b->pieces[INDEX_OF(MOVING, INDEX_KING)]), OPPONENT);
+}
+
+bool position_is_legal(const Bitboard* b) {
+    const uint64_t* p = b->pieces;
+    if (popcount(p[INDEX_WKING]) != 1 || popcount(p[INDEX_BKING]) != 1) return false;
+    if ((p[INDEX_WPAWN] | p[INDEX_BPAWN]) & (MASK_RANK_1 | MASK_RANK_8)) return false;
+    // The side to move could take the king.
+    if (is_square_attacked(b, lsb(p[INDEX_OF(OPPONENT, INDEX_KING)]), MOVING)) return false;
+
+    static const struct { uint8_t right; int king; int rook; int side; } castles[4] = {
+        {CASTLE_WHITE_K, 4, 7, WHITE}, {CASTLE_WHITE_Q, 4, 0, WHITE},
+        {CASTLE_BLACK_K, 60, 63, BLACK}, {CASTLE_BLACK_Q, 60, 56, BLACK},
+    };
+    for (int i = 0; i < 4; i++) {
+        if (!(b->castling_rights & castles[i].right)) continue;
+        if (!(p[INDEX_OF(castles[i].side, INDEX_KING)] & (1ULL << castles[i].king))) return false;
+        if (!(p[INDEX_OF(castles[i].side, INDEX_ROOK)] & (1ULL << castles[i].rook))) return false;
+    }
+
+    if (b->en_passant_target) {
+        // Empty, on the third rank of the side that just moved, with its pawn in front.
+        const int sq = lsb(b->en_passant_target);
+        const int pawn = MOVING == WHITE ? sq - 8 : sq + 8;
+        if (b->en_passant_target & b->all_occupancy) return false;
+        if (b->en_passant_rank != (MOVING == WHITE ? 5 : 2)) return false;
+        if (!(p[INDEX_OF(OPPONENT, INDEX_PAWN)] & (1ULL << pawn))) return false;
+    }
+    return true;
+}
+
+// --- Move generation ---
+
+static inline void add_moves_from(MoveList* list, const int from, uint64_t targets) {
+    while (targets) {
+        list->moves[list->count++] = MOVE_MAKE(from, pop_lsb(&targets));
+    }
+}
+
+static inline void add_promotions(MoveList* list, const int from, const int to) {
+    list->moves[list->count++] = MOVE_MAKE_PROMO(from, to, PIECE_QUEEN);
+    list->moves[list->count++] = MOVE_MAKE_PROMO(from, to, PIECE_ROOK);
+    list->moves[list->count++] = MOVE_MAKE_PROMO(from, to, PIECE_BISHOP);
+    list->moves[list->count++] = MOVE_MAKE_PROMO(from, to, PIECE_KNIGHT);
+}
+
+// Pawn targets come from set-wise shifts, so each to-square maps back to its from-square by a fixed offset.
+static inline void add_pawn_moves(MoveList* list, uint64_t targets, const int from_offset, const uint64_t promo_rank) {
+    while (targets) {
+        const int to = pop_lsb(&targets);
+        if ((1ULL << to) & promo_rank) add_promotions(list, to + from_offset, to);
+        else list->moves[list->count++] = MOVE_MAKE(to + from_offset, to);
+    }
+}
+
+static inline void generate_pawn_moves(const Bitboard* b, MoveList* list, const bool us) {
+    const uint64_t pawns = b->pieces[INDEX_OF(us, INDEX_PAWN)];
+    const uint64_t enemies = us == WHITE ? b->black_occupancy : b->white_occupancy;
+    const uint64_t promo_rank = us == WHITE ? MASK_RANK_8 : MASK_RANK_1;
+    const int up = us == WHITE ? 8 : -8;
+
+    // Single and double pushes. A double push target can only be reached if the
+    // square in between is empty, so a pawn one step behind means a single push.
+    uint64_t pushes = generate_pawn_movement(pawns, ~b->all_occupancy, us);
+    while (pushes) {
+        const int to = pop_lsb(&pushes);
+        const int from = (pawns & (1ULL << (to - up))) ? to - up : to - 2 * up;
+        if ((1ULL << to) & promo_rank) add_promotions(list, from, to);
+        else list->moves[list->count++] = MOVE_MAKE(from, to);
+    }
+
+    if (us == WHITE) {
+        add_pawn_moves(list, ((pawns & NOT_FILE_A) << 7) & enemies, -7, promo_rank);
+        add_pawn_moves(list, ((pawns & NOT_FILE_H) << 9) & enemies, -9, promo_rank);
+    } else {
+        add_pawn_moves(list, ((pawns & NOT_FILE_A) >> 9) & enemies, 9, promo_rank);
+        add_pawn_moves(list, ((pawns & NOT_FILE_H) >> 7) & enemies, 7, promo_rank);
+    }
+
+    if (b->en_passant_target) {
+        const int ep_square = lsb(b->en_passant_target);
+        uint64_t capturers = PAWN_ATTACKS[!us][ep_square] & pawns;
+        while (capturers) {
+            list->moves[list->count++] = MOVE_MAKE_FLAG(pop_lsb(&capturers), ep_square, MOVE_FLAG_ENPASSANT);
+        }
+    }
+}
+
+// Quiescence moves only: captures, with promotions by capture to a queen alone,
+// queen promotions by push, and en passant.
+static inline void add_pawn_captures(MoveList* list, uint64_t targets, const int from_offset, const uint64_t promo_rank) {
+    while (targets) {
+        const int to = pop_lsb(&targets);
+        if ((1ULL << to) & promo_rank) list->moves[list->count++] = MOVE_MAKE_PROMO(to + from_offset, to, PIECE_QUEEN);
+        else list->moves[list->count++] = MOVE_MAKE(to + from_offset, to);
+    }
+}
+
+static inline void generate_pawn_captures(const Bitboard* b, MoveList* list, const bool us) {
+    const uint64_t pawns = b->pieces[INDEX_OF(us, INDEX_PAWN)];
+    const uint64_t enemies = us == WHITE ? b->black_occupancy : b->white_occupancy;
+    const uint64_t empty = ~b->all_occupancy;
+
+    if (us == WHITE) {
+        add_pawn_captures(list, (pawns << 8) & empty & MASK_RANK_8, -8, MASK_RANK_8);
+        add_pawn_captures(list, ((pawns & NOT_FILE_A) << 7) & enemies, -7, MASK_RANK_8);
+        add_pawn_captures(list, ((pawns & NOT_FILE_H) << 9) & enemies, -9, MASK_RANK_8);
+    } else {
+        add_pawn_captures(list, (pawns >> 8) & empty & MASK_RANK_1, 8, MASK_RANK_1);
+        add_pawn_captures(list, ((pawns & NOT_FILE_A) >> 9) & enemies, 9, MASK_RANK_1);
+        add_pawn_captures(list, ((pawns & NOT_FILE_H) >> 7) & enemies, 7, MASK_RANK_1);
+    }
+
+    if (b->en_passant_target) {
+        const int ep_square = lsb(b->en_passant_target);
+        uint64_t capturers = PAWN_ATTACKS[!us][ep_square] & pawns;
+        while (capturers) {
+            list->moves[list->count++] = MOVE_MAKE_FLAG(pop_lsb(&capturers), ep_square, MOVE_FLAG_ENPASSANT);
+        }
+    }
+}
+
+static inline void generate_piece_moves(const Bitboard* b, MoveList* list, const bool us, const uint64_t targets) {
+    const uint64_t* p = &b->pieces[INDEX_OF(us, INDEX_PAWN)];
+    const uint64_t occupancy = b->all_occupancy;
+    uint64_t pieces;
+
+    pieces = p[INDEX_KNIGHT];
+    while (pieces) {
+        const int from = pop_lsb(&pieces);
+        add_moves_from(list, from, KNIGHT_ATTACKS[from] & targets);
+    }
+
+    // Queens are handled as a bishop plus a rook; the two target sets never overlap.
+    pieces = p[INDEX_BISHOP] | p[INDEX_QUEEN];
+    while (pieces) {
+        const int from = pop_lsb(&pieces);
+        add_moves_from(list, from, bishop_attacks(from, occupancy) & targets);
+    }
+
+    pieces = p[INDEX_ROOK] | p[INDEX_QUEEN];
+    while (pieces) {
+        const int from = pop_lsb(&pieces);
+        add_moves_from(list, from, rook_attacks(from, occupancy) & targets);
+    }
+
+    const int king = lsb(p[INDEX_KING]);
+    add_moves_from(list, king, KING_ATTACKS[king] & targets);
+}
+
+static inline void generate_castling(const Bitboard* b, MoveList* list, const bool us) {
+    const uint64_t occupancy = b->all_occupancy;
+    const bool them = !us;
+
+    if (us == WHITE) {
+        if ((b->castling_rights & CASTLE_WHITE_K) && !(occupancy & 0x60ULL) &&
+            !is_square_attacked(b, 4, them) && !is_square_attacked(b, 5, them) && !is_square_attacked(b, 6, them)) {
+            list->moves[list->count++] = MOVE_MAKE_FLAG(4, CASTLE_WK_TO, MOVE_FLAG_CASTLE);
+        }
+        if ((b->castling_rights & CASTLE_WHITE_Q) && !(occupancy & 0x0EULL) &&
+            !is_square_attacked(b, 4, them) && !is_square_attacked(b, 3, them) && !is_square_attacked(b, 2, them)) {
+            list->moves[list->count++] = MOVE_MAKE_FLAG(4, CASTLE_WQ_TO, MOVE_FLAG_CASTLE);
+        }
+    } else {
+        if ((b->castling_rights & CASTLE_BLACK_K) && !(occupancy & 0x6000000000000000ULL) &&
+            !is_square_attacked(b, 60, them) && !is_square_attacked(b, 61, them) && !is_square_attacked(b, 62, them)) {
+            list->moves[list->count++] = MOVE_MAKE_FLAG(60, CASTLE_BK_TO, MOVE_FLAG_CASTLE);
+        }
+        if ((b->castling_rights & CASTLE_BLACK_Q) && !(occupancy & 0x0E00000000000000ULL) &&
+            !is_square_attacked(b, 60, them) && !is_square_attacked(b, 59, them) && !is_square_attacked(b, 58, them)) {
+            list->moves[list->count++] = MOVE_MAKE_FLAG(60, CASTLE_BQ_TO, MOVE_FLAG_CASTLE);
+        }
+    }
+}
+
+void generate_moves(const Bitboard* b, MoveList* list) {
+    const bool us = MOVING;
+    const uint64_t own = us == WHITE ? b->white_occupancy : b->black_occupancy;
+
+    generate_pawn_moves(b, list, us);
+    generate_piece_moves(b, list, us, ~own);
+    if (b->castling_rights & (us == WHITE ? CASTLE_WHITE : CASTLE_BLACK)) generate_castling(b, list, us);
+}
+
+void generate_captures(const Bitboard* b, MoveList* list) {
+    const bool us = MOVING;
+    const uint64_t enemies = us == WHITE ? b->black_occupancy : b->white_occupancy;
+
+    generate_pawn_captures(b, list, us);
+    generate_piece_moves(b, list, us, enemies);
+}
+
+// --- Legality ---
 
 typedef struct {
-    Move moves[MAX_MOVES];
-    size_t count;
-} MoveList;
-
-// Placeholders for move generation
-MoveList generate_white_pawn_moves(Bitboard board) { MoveList ml = {0}; return ml; }
-MoveList generate_white_knight_moves(Bitboard board) { MoveList ml = {0}; return ml; }
-MoveList generate_white_bishop_moves(Bitboard board) { MoveList ml = {0}; return ml; }
-MoveList generate_white_rook_moves(Bitboard board) { MoveList ml = {0}; return ml; }
-MoveList generate_white_queen_moves(Bitboard board) { MoveList ml = {0}; return ml; }
-MoveList generate_white_king_moves(Bitboard board) { MoveList ml = {0}; return ml; }
-
-MoveList generate_black_pawn_moves(Bitboard board) { MoveList ml = {0}; return ml; }
-MoveList generate_black_knight_moves(Bitboard board) { MoveList ml = {0}; return ml; }
-MoveList generate_black_bishop_moves(Bitboard board) { MoveList ml = {0}; return ml; }
-MoveList generate_black_rook_moves(Bitboard board) { MoveList ml = {0}; return ml; }
-MoveList generate_black_queen_moves(Bitboard board) { MoveList ml = {0}; return ml; }
-MoveList generate_black_king_moves(Bitboard board) { MoveList ml = {0}; return ml; }
-
-MoveList generate_moves(Bitboard board, int piece_type) {
-    switch (piece_type) {
-        case PIECE_WPAWN: return generate_white_pawn_moves(board);
-        case PIECE_WKNIGHT: return generate_white_knight_moves(board);
-        case PIECE_WBISHOP: return generate_white_bishop_moves(board);
-        case PIECE_WROOK: return generate_white_rook_moves(board);
-        case PIECE_WQUEEN: return generate_white_queen_moves(board);
-        case PIECE_WKING: return generate_white_king_moves(board);
-        case PIECE_BPAWN: return generate_black_pawn_moves(board);
-        case PIECE_BKNIGHT: return generate_black_knight_moves(board);
-        case PIECE_BBISHOP: return generate_black_bishop_moves(board);
-        case PIECE_BROOK: return generate_black_rook_moves(board);
-        case PIECE_BQUEEN: return generate_black_queen_moves(board);
-        case PIECE_BKING: return generate_black_king_moves(board);
-        default: { MoveList ml = {0}; return ml; }
-    }
-}
-
-struct TreeNode {
-	Move move;
-    Bitboard state;
-    struct TreeNode *parent;
-    struct TreeNode **children;
-	uint16_t score;
-	uint8_t depth;
-}TreeNode;
-
-uint16_t evaluate_position( struct TreeNode *Node) {
-    return 0;
-}
\ No newline at end of file
+    uint64_t pinned;     // own pieces pinned to the king
+    uint64_t checkers;   // enemy pieces giving check
+    int king;
+} KingSafety;
+
+static inline KingSafety king_safety(const Bitboard* b) {
+    KingSafety ks;
+    const bool us = MOVING;
+    const uint64_t* e = &b->pieces[INDEX_OF(!us, INDEX_PAWN)];
+    const uint64_t own = us == WHITE ? b->white_occupancy : b->black_occupancy;
+    const uint64_t occupancy = b->all_occupancy;
+    const uint64_t rooks = e[INDEX_ROOK] | e[INDEX_QUEEN];
+    const uint64_t bishops = e[INDEX_BISHOP] | e[INDEX_QUEEN];
+
+    ks.king = lsb(b->pieces[INDEX_OF(us, INDEX_KING)]);
+
+    ks.checkers = (PAWN_ATTACKS[us][ks.king] & e[INDEX_PAWN])
+                | (KNIGHT_ATTACKS[ks.king] & e[INDEX_KNIGHT])
+                | (bishop_attacks(ks.king, occupancy) & bishops)
+                | (rook_attacks(ks.king, occupancy) & rooks);
+
+    // Sliders aimed at the king through exactly one piece pin it if that piece is ours.
+    ks.pinned = 0ULL;
+    uint64_t snipers = (rook_attacks(ks.king, 0) & rooks) | (bishop_attacks(ks.king, 0) & bishops);
+    while (snipers) {
+        const uint64_t blockers = BETWEEN[ks.king][pop_lsb(&snipers)] & occupancy;
+        if (blockers && !(blockers & (blockers - 1))) ks.pinned |= blockers & own;
+    }
+    return ks;
+}
+
+static bool is_legal_with(const Bitboard* b, const move16 m, const KingSafety* ks) {
+    const int from = MOVE_FROM(m);
+    const int to = MOVE_TO(m);
+
+    if (from == ks->king) {
+        if (MOVE_FLAG(m) == MOVE_FLAG_CASTLE) return true;   // path was checked by the generator
+        // The king must not stay on a slider's ray, so look through its own square.
+        return !square_attacked_through(b, to, OPPONENT, b->all_occupancy ^ (1ULL << from));
+    }
+
+    // En passant removes two pieces from a rank at once; just try it.
+    if (MOVE_FLAG(m) == MOVE_FLAG_ENPASSANT) {
+        Bitboard after = MakeMove(m, *b);
+        return !is_square_attacked(&after, ks->king, OPPONENT);
+    }
+
+    if (ks->checkers) {
+        if (ks->checkers & (ks->checkers - 1)) return false;   // double check: king moves only
+        const int checker = lsb(ks->checkers);
+        if (!((BETWEEN[ks->king][checker] | ks->checkers) & (1ULL << to))) return false;
+    }
+
+    return !(ks->pinned & (1ULL << from)) || (LINE[ks->king][from] & (1ULL << to));
+}
+
+bool is_legal(const Bitboard* b, const move16 m) {
+    const KingSafety ks = king_safety(b);
+    return is_legal_with(b, m, &ks);
+}
+
+static void keep_legal(const Bitboard* b, MoveList* list, const size_t start) {
+    const KingSafety ks = king_safety(b);
+    size_t kept = start;
+    for (size_t i = start; i < list->count; i++) {
+        if (is_legal_with(b, list->moves[i], &ks)) list->moves[kept++] = list->moves[i];
+    }
+    list->count = kept;
+}
+
+void generate_legal_moves(const Bitboard* b, MoveList* list) {
+    const size_t start = list->count;
+    generate_moves(b, list);
+    keep_legal(b, list, start);
+}
+
+#ifdef CHESS_DEBUG_CHECKS
+// The capture generator must agree with the full one filtered down to its move set.
+static void verify_captures(const Bitboard* b, const MoveList* list, const size_t start) {
+    MoveList all;
+    all.count = 0;
+    generate_legal_moves(b, &all);
+    size_t expected = 0;
+    for (size_t i = 0; i < all.count; i++) {
+        const move16 m = all.moves[i];
+        const bool capture = (b->all_occupancy & (1ULL << MOVE_TO(m))) || MOVE_FLAG(m) == MOVE_FLAG_ENPASSANT;
+        if (IS_PROMO(m) ? MOVE_PROMO(m) != PIECE_QUEEN : !capture) continue;
+        expected++;
+        bool found = false;
+        for (size_t j = start; j < list->count && !found; j++) found = list->moves[j] == m;
+        if (!found) {
+            char move[6];
+            move_to_string(m, move);
+            fprintf(stderr, "generate_legal_captures: missing %s\n", move);
+            exit(EXIT_FAILURE);
+        }
+    }
+    if (expected != list->count - start) {
+        fprintf(stderr, "generate_legal_captures: %zu moves, expected %zu\n", list->count - start, expected);
+        exit(EXIT_FAILURE);
+    }
+}
+#endif
+
+void generate_legal_captures(const Bitboard* b, MoveList* list) {
+    const size_t start = list->count;
+    generate_captures(b, list);
+    keep_legal(b, list, start);
+#ifdef CHESS_DEBUG_CHECKS
+    verify_captures(b, list, start);
+#endif
+}
@@ -0,0 +1,49 @@
+//
+// Created by lenovo on 10/18/2026.
+//
+
+#ifndef MOVEGENERATION_H
+#define MOVEGENERATION_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "constants.h"
+#include "bitboard.h"
+#include "move.h"
+
+// Caller-owned move buffer, meant to live on the stack of whoever is iterating it.
+typedef struct {
+    move16 moves[MAX_MOVES];
+    size_t count;
+} MoveList;
+
+// Appends every pseudo-legal move for the side to move to `list` (which the caller
+// must have initialised). Moves may leave the own king in check; castling through
+// or out of check is never generated.
+void generate_moves(const Bitboard* b, MoveList* list);
+
+// Same, keeping only legal moves. Legality is decided from pins and checkers
+// without making the moves.
+void generate_legal_moves(const Bitboard* b, MoveList* list);
+bool is_legal(const Bitboard* b, move16 m);
+
+// Quiescence moves: captures (promoting to a queen only), queen promotions and en
+// passant, generated straight from the attack sets masked with the enemy pieces.
+// Pseudo-legal and legal variants, as above.
+void generate_captures(const Bitboard* b, MoveList* list);
+void generate_legal_captures(const Bitboard* b, MoveList* list);
+
+bool is_square_attacked(const Bitboard* b, int sq, bool by_side);
+
+// Pieces of both sides attacking `sq` with the sliders blocked by `occupancy`, not
+// by the board's own. Pieces absent from `occupancy` still appear: mask them out.
+uint64_t attackers_to(const Bitboard* b, int sq, uint64_t occupancy);
+bool in_check(const Bitboard* b);
+
+// Whether the search can be trusted with `b`: one king per side, the side not to
+// move not in check, no pawns on the back ranks, castling rights backed by a king
+// and rook on their squares and an en passant square behind a pawn that just moved.
+bool position_is_legal(const Bitboard* b);
+
+#endif //MOVEGENERATION_H
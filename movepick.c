@@ -0,0 +1,78 @@
+//
+// Created by lenovo on 10/18/2026.
+//
+#include <stdint.h>
+#include "constants.h"
+#include "bitboard.h"
+#include "move.h"
+#include "movegeneration.h"
+#include "see.h"
+#include "movepick.h"
+
+// Bands above any history score, highest first.
+#define SCORE_HASH        (1 << 30)
+#define SCORE_CAPTURE     (1 << 28)
+#define SCORE_KILLER      (1 << 27)
+#define SCORE_COUNTER     (1 << 26)
+#define SCORE_UNDERPROMO  (-HISTORY_MAX - 1)
+#define SCORE_BAD_CAPTURE (-HISTORY_MAX - 1024)    // captures that lose material, after every quiet
+
+static int score_move(const Bitboard* b, const move16 m, const move16 hash_move, const move16 killers[2],
+                      const move16 countermove, const MoveHistory* h) {
+    if (m == hash_move) return SCORE_HASH;
+
+    const int from = MOVE_FROM(m), to = MOVE_TO(m);
+    const bool promotion = IS_PROMO(m);
+    if (promotion && MOVE_PROMO(m) != INDEX_QUEEN) return SCORE_UNDERPROMO;
+    if (promotion || IS_CAPTURE(b, m)) {
+        // Most valuable victim first, least valuable attacker among equal victims.
+        const int victim = MOVE_FLAG(m) == MOVE_FLAG_ENPASSANT ? INDEX_PAWN + 1
+                         : (b->all_occupancy & (1ULL << to)) ? INDEX_TYPE(piece_on(b, to)) + 1 : 0;
+        const int attacker = INDEX_TYPE(piece_on(b, from));
+        const int mvv_lva = (victim + (promotion ? INDEX_QUEEN : 0)) * 16 - attacker;
+        // A queen promotion always gains; a capture only if the exchange does.
+        return promotion || see_ge(b, m, 0) ? SCORE_CAPTURE + mvv_lva : SCORE_BAD_CAPTURE + mvv_lva;
+    }
+
+    if (m == killers[0]) return SCORE_KILLER + 1;
+    if (m == killers[1]) return SCORE_KILLER;
+    if (m == countermove) return SCORE_COUNTER;
+    return h->butterfly[b->to_move][from][to];
+}
+
+void picker_init(MovePicker* p, const Bitboard* b, MoveList* list, const move16 hash_move, const move16 killers[2],
+                 const move16 countermove, const MoveHistory* h) {
+    p->list = list;
+    p->next = 0;
+    for (size_t i = 0; i < list->count; i++) {
+        p->scores[i] = score_move(b, list->moves[i], hash_move, killers, countermove, h);
+    }
+}
+
+move16 picker_next(MovePicker* p) {
+    MoveList* list = p->list;
+    if (p->next >= list->count) return MOVE_NONE;
+
+    // One selection-sort step: swap the best remaining move to the front.
+    size_t best = p->next;
+    for (size_t i = p->next + 1; i < list->count; i++) {
+        if (p->scores[i] > p->scores[best]) best = i;
+    }
+    const move16 m = list->moves[best];
+    const int score = p->scores[best];
+    list->moves[best] = list->moves[p->next];
+    p->scores[best] = p->scores[p->next];
+    list->moves[p->next] = m;
+    p->scores[p->next] = score;
+    p->next++;
+    return m;
+}
+
+bool picker_bad_capture(const MovePicker* p) {
+    return p->next > 0 && p->scores[p->next - 1] < SCORE_UNDERPROMO;
+}
+
+void history_age(MoveHistory* h) {
+    int16_t* entry = &h->butterfly[0][0][0];
+    for (size_t i = 0; i < sizeof(h->butterfly) / sizeof(int16_t); i++) entry[i] /= 2;
+}
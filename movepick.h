@@ -0,0 +1,53 @@
+//
+// Created by lenovo on 10/18/2026.
+//
+
+#ifndef MOVEPICK_H
+#define MOVEPICK_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "constants.h"
+#include "bitboard.h"
+#include "move.h"
+#include "movegeneration.h"
+
+#define HISTORY_MAX 16384       // |butterfly history| stays below this
+
+// Quiet-move statistics of one search thread, kept across searches and aged at the
+// start of each.
+typedef struct {
+    int16_t butterfly[2][64][64];       // [side][from][to]
+    move16 countermoves[12][64];        // [piece index][to] of the previous move
+} MoveHistory;
+
+// Scores a generated move list once into a parallel array, then hands out the
+// best remaining move on each call, so a node that cuts off early never sorts the
+// rest. Order: hash move, queen promotions and captures that don't lose material
+// (SEE >= 0) by MVV-LVA, the two killers, the countermove, quiet moves by butterfly
+// history, underpromotions, losing captures by MVV-LVA.
+typedef struct {
+    MoveList* list;
+    int scores[MAX_MOVES];
+    size_t next;
+} MovePicker;
+
+void picker_init(MovePicker* p, const Bitboard* b, MoveList* list, move16 hash_move, const move16 killers[2],
+                 move16 countermove, const MoveHistory* h);
+
+// MOVE_NONE once every move has been returned.
+move16 picker_next(MovePicker* p);
+
+// Whether the move picker_next just returned is a losing capture (SEE < 0).
+bool picker_bad_capture(const MovePicker* p);
+
+// Halves every history score, so old searches fade but still guide the next.
+void history_age(MoveHistory* h);
+
+// Gravity update: moves `entry` towards +-HISTORY_MAX by `bonus`, less as it nears the bound.
+static inline void history_update(int16_t* entry, const int bonus) {
+    const int clamped = bonus > HISTORY_MAX ? HISTORY_MAX : bonus < -HISTORY_MAX ? -HISTORY_MAX : bonus;
+    *entry = (int16_t)(*entry + clamped - *entry * (clamped < 0 ? -clamped : clamped) / HISTORY_MAX);
+}
+
+#endif //MOVEPICK_H
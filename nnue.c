@@ -0,0 +1,462 @@
+//
+// Created by lenovo on 10/18/2026.
+//
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include "constants.h"
+#include "bitboard.h"
+#include "nnue.h"
+#include "eval.h"
+#include "utils.h"
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define CHESS_HAVE_AVX2
+#include <immintrin.h>
+#endif
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+typedef struct {
+    const int16_t* ft_bias;
+    const int16_t* ft_weights;
+    const int32_t* ft_psqt;
+    const int32_t* l1_bias;
+    const int8_t* l1_weights;
+    const int32_t* l2_bias;
+    const int8_t* l2_weights;
+    const int32_t* out_bias;
+    const int8_t* out_weights;
+} Network;
+
+static Network net;
+static bool loaded;
+
+// --- Features ---
+
+static inline int feature(const int perspective, const int king_sq, const int index, const int sq) {
+    const int flip = perspective == WHITE ? 0 : 56;
+    const int piece = (INDEX_SIDE(index) != perspective) * 5 + INDEX_TYPE(index);
+    return (king_sq ^ flip) * NNUE_PIECE_SQUARES + piece * 64 + (sq ^ flip);
+}
+
+static inline int king_square(const Bitboard* b, const int perspective) {
+    return lsb(b->pieces[INDEX_OF(perspective, INDEX_KING)]);
+}
+
+// --- Kernels ---
+// Scalar and AVX2 versions compute bit-identical results: int16 accumulators wrap
+// the same way, and the int8 dot products stay inside maddubs' int16 range because
+// inputs are at most 127.
+
+typedef void (*AccumulateKernel)(int16_t* out, const int16_t* in, const int16_t* const* add, int adds,
+                                 const int16_t* const* sub, int subs);
+typedef void (*ClipKernel)(const int16_t* in, uint8_t* out);       // NNUE_HALF values to [0, 127]
+typedef void (*AffineKernel)(const uint8_t* in, int inputs, const int8_t* weights, const int32_t* bias,
+                             int32_t* out, int outputs);
+
+static void accumulate_scalar(int16_t* out, const int16_t* in, const int16_t* const* add, const int adds,
+                              const int16_t* const* sub, const int subs) {
+    for (int i = 0; i < NNUE_HALF; i++) {
+        int value = in[i];
+        for (int k = 0; k < adds; k++) value += add[k][i];
+        for (int k = 0; k < subs; k++) value -= sub[k][i];
+        out[i] = (int16_t)value;
+    }
+}
+
+static void clip_scalar(const int16_t* in, uint8_t* out) {
+    for (int i = 0; i < NNUE_HALF; i++) out[i] = (uint8_t)(in[i] < 0 ? 0 : in[i] > 127 ? 127 : in[i]);
+}
+
+static void affine_scalar(const uint8_t* in, const int inputs, const int8_t* weights, const int32_t* bias,
+                          int32_t* out, const int outputs) {
+    for (int j = 0; j < outputs; j++) {
+        const int8_t* row = weights + (size_t)j * (size_t)inputs;
+        int32_t sum = bias[j];
+        for (int i = 0; i < inputs; i++) sum += in[i] * row[i];
+        out[j] = sum;
+    }
+}
+
+#ifdef CHESS_HAVE_AVX2
+__attribute__((target("avx2")))
+static void accumulate_avx2(int16_t* out, const int16_t* in, const int16_t* const* add, const int adds,
+                            const int16_t* const* sub, const int subs) {
+    for (int i = 0; i < NNUE_HALF; i += 16) {
+        __m256i v = _mm256_loadu_si256((const __m256i*)(in + i));
+        for (int k = 0; k < adds; k++) v = _mm256_add_epi16(v, _mm256_loadu_si256((const __m256i*)(add[k] + i)));
+        for (int k = 0; k < subs; k++) v = _mm256_sub_epi16(v, _mm256_loadu_si256((const __m256i*)(sub[k] + i)));
+        _mm256_storeu_si256((__m256i*)(out + i), v);
+    }
+}
+
+__attribute__((target("avx2")))
+static void clip_avx2(const int16_t* in, uint8_t* out) {
+    const __m256i zero = _mm256_setzero_si256();
+    for (int i = 0; i < NNUE_HALF; i += 32) {
+        const __m256i a = _mm256_loadu_si256((const __m256i*)(in + i));
+        const __m256i b = _mm256_loadu_si256((const __m256i*)(in + i + 16));
+        // packs saturates to [-128, 127] per 128-bit lane; the permute restores the order.
+        const __m256i packed = _mm256_max_epi8(_mm256_packs_epi16(a, b), zero);
+        _mm256_storeu_si256((__m256i*)(out + i), _mm256_permute4x64_epi64(packed, 0xD8));
+    }
+}
+
+__attribute__((target("avx2")))
+static inline int32_t hsum_avx2(const __m256i v) {
+    __m128i s = _mm_add_epi32(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1));
+    s = _mm_add_epi32(s, _mm_shuffle_epi32(s, 0x4E));
+    s = _mm_add_epi32(s, _mm_shuffle_epi32(s, 0xB1));
+    return _mm_cvtsi128_si32(s);
+}
+
+// Four rows at a time share each input load and keep four independent sums in flight.
+__attribute__((target("avx2")))
+static void affine_avx2(const uint8_t* in, const int inputs, const int8_t* weights, const int32_t* bias,
+                        int32_t* out, const int outputs) {
+    const __m256i ones = _mm256_set1_epi16(1);
+    int j = 0;
+    for (; j + 4 <= outputs; j += 4) {
+        const int8_t* row = weights + (size_t)j * (size_t)inputs;
+        __m256i sum[4] = {_mm256_setzero_si256(), _mm256_setzero_si256(), _mm256_setzero_si256(),
+                          _mm256_setzero_si256()};
+        for (int i = 0; i < inputs; i += 32) {
+            const __m256i x = _mm256_loadu_si256((const __m256i*)(in + i));
+            for (int r = 0; r < 4; r++) {
+                const __m256i w = _mm256_loadu_si256((const __m256i*)(row + (size_t)r * (size_t)inputs + i));
+                sum[r] = _mm256_add_epi32(sum[r], _mm256_madd_epi16(_mm256_maddubs_epi16(x, w), ones));
+            }
+        }
+        for (int r = 0; r < 4; r++) out[j + r] = bias[j + r] + hsum_avx2(sum[r]);
+    }
+    for (; j < outputs; j++) {
+        const int8_t* row = weights + (size_t)j * (size_t)inputs;
+        __m256i sum = _mm256_setzero_si256();
+        for (int i = 0; i < inputs; i += 32) {
+            const __m256i x = _mm256_loadu_si256((const __m256i*)(in + i));
+            const __m256i w = _mm256_loadu_si256((const __m256i*)(row + i));
+            sum = _mm256_add_epi32(sum, _mm256_madd_epi16(_mm256_maddubs_epi16(x, w), ones));
+        }
+        out[j] = bias[j] + hsum_avx2(sum);
+    }
+}
+#endif
+
+static AccumulateKernel accumulate = accumulate_scalar;
+static ClipKernel clip = clip_scalar;
+static AffineKernel affine = affine_scalar;
+
+bool nnue_use_avx2(const bool avx2) {
+    if (!avx2) {
+        accumulate = accumulate_scalar;
+        clip = clip_scalar;
+        affine = affine_scalar;
+        return true;
+    }
+#ifdef CHESS_HAVE_AVX2
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        accumulate = accumulate_avx2;
+        clip = clip_avx2;
+        affine = affine_avx2;
+        return true;
+    }
+#endif
+    return false;
+}
+
+bool nnue_avx2(void) {
+    return accumulate != accumulate_scalar;
+}
+
+// --- Accumulators ---
+
+static void refresh(NnueAccumulator* acc, const Bitboard* b, const int perspective) {
+    const int16_t* add[32];
+    const int16_t* base = net.ft_bias;
+    int adds = 0;
+    int32_t psqt = 0;
+    const int king_sq = king_square(b, perspective);
+    for (int index = 0; index < 12; index++) {
+        if (INDEX_TYPE(index) == INDEX_KING) continue;
+        uint64_t pieces = b->pieces[index];
+        while (pieces) {
+            const int f = feature(perspective, king_sq, index, pop_lsb(&pieces));
+            psqt += net.ft_psqt[f];
+            add[adds++] = net.ft_weights + (size_t)f * NNUE_HALF;
+            if (adds == 32) {
+                accumulate(acc->values[perspective], base, add, adds, NULL, 0);
+                base = acc->values[perspective];
+                adds = 0;
+            }
+        }
+    }
+    accumulate(acc->values[perspective], base, add, adds, NULL, 0);
+    acc->psqt[perspective] = psqt;
+    acc->computed[perspective] = true;
+}
+
+// Brings `next` up to date from `prev` with the changes recorded in `next`.
+static void apply_changes(const NnueAccumulator* prev, NnueAccumulator* next, const int perspective,
+                          const int king_sq) {
+    const int16_t* add[NNUE_MAX_CHANGES];
+    const int16_t* sub[NNUE_MAX_CHANGES];
+    int adds = 0, subs = 0;
+    int32_t psqt = prev->psqt[perspective];
+    for (int i = 0; i < next->change_count; i++) {
+        const NnueChange* c = &next->changes[i];
+        const int f = feature(perspective, king_sq, c->index, c->sq);
+        const int16_t* row = net.ft_weights + (size_t)f * NNUE_HALF;
+        if (c->sign > 0) {
+            add[adds++] = row;
+            psqt += net.ft_psqt[f];
+        } else {
+            sub[subs++] = row;
+            psqt -= net.ft_psqt[f];
+        }
+    }
+    accumulate(next->values[perspective], prev->values[perspective], add, adds, sub, subs);
+    next->psqt[perspective] = psqt;
+    next->computed[perspective] = true;
+}
+
+static void update(NnueAccumulator* acc, const Bitboard* b, const int perspective) {
+    // The root entry is always computed, so the walk ends there at the latest.
+    NnueAccumulator* last = acc;
+    while (!last->computed[perspective]) {
+        if (last->king_moved[perspective]) {
+            refresh(acc, b, perspective);
+            return;
+        }
+        last--;
+    }
+    const int king_sq = king_square(b, perspective);
+    for (NnueAccumulator* next = last + 1; next <= acc; next++) apply_changes(next - 1, next, perspective, king_sq);
+}
+
+void nnue_attach(Bitboard* b, NnueAccumulator* stack) {
+    stack->change_count = 0;
+    for (int p = WHITE; p <= BLACK; p++) {
+        stack->computed[p] = false;
+        stack->king_moved[p] = false;
+        refresh(stack, b, p);
+    }
+    b->nnue = stack;
+}
+
+// --- Evaluation ---
+
+static inline void clip_hidden(const int32_t* in, uint8_t* out, const int count) {
+    for (int i = 0; i < count; i++) {
+        const int32_t v = in[i] >> NNUE_SHIFT;
+        out[i] = (uint8_t)(v < 0 ? 0 : v > 127 ? 127 : v);
+    }
+}
+
+int nnue_evaluate(const Bitboard* b) {
+    NnueAccumulator* acc = b->nnue;
+    for (int p = WHITE; p <= BLACK; p++) {
+        if (!acc->computed[p]) update(acc, b, p);
+    }
+
+#ifdef CHESS_DEBUG_CHECKS
+    NnueAccumulator fresh = {0};
+    for (int p = WHITE; p <= BLACK; p++) refresh(&fresh, b, p);
+    if (memcmp(fresh.values, acc->values, sizeof(fresh.values)) != 0 ||
+        memcmp(fresh.psqt, acc->psqt, sizeof(fresh.psqt)) != 0) {
+        fprintf(stderr, "NNUE accumulator mismatch\n");
+        print_board(*b);
+        abort();
+    }
+#endif
+
+    const int us = b->to_move, them = !b->to_move;
+    uint8_t input[2 * NNUE_HALF];
+    int32_t l1[NNUE_L1], l2[NNUE_L2], out;
+    uint8_t l1_clipped[NNUE_L1], l2_clipped[NNUE_L2];
+
+    clip(acc->values[us], input);
+    clip(acc->values[them], input + NNUE_HALF);
+    affine(input, 2 * NNUE_HALF, net.l1_weights, net.l1_bias, l1, NNUE_L1);
+    clip_hidden(l1, l1_clipped, NNUE_L1);
+    affine(l1_clipped, NNUE_L1, net.l2_weights, net.l2_bias, l2, NNUE_L2);
+    clip_hidden(l2, l2_clipped, NNUE_L2);
+    affine(l2_clipped, NNUE_L2, net.out_weights, net.out_bias, &out, 1);
+
+    return (acc->psqt[us] - acc->psqt[them]) / 2 + out / NNUE_OUTPUT_SCALE;
+}
+
+// --- Weight file ---
+
+static uint32_t align64(const uint32_t offset) {
+    return (offset + 63) & ~63U;
+}
+
+// Lays the sections out after the header; returns the file size.
+static uint32_t layout(NnueHeader* h) {
+    memset(h, 0, sizeof(*h));
+    memcpy(h->tag, NNUE_TAG, sizeof(h->tag));
+    h->version = NNUE_VERSION;
+    h->endian = NNUE_ENDIAN;
+    h->header_size = sizeof(NnueHeader);
+    h->inputs = NNUE_INPUTS;
+    h->half = NNUE_HALF;
+    h->l1 = NNUE_L1;
+    h->l2 = NNUE_L2;
+
+    uint32_t offset = align64(sizeof(NnueHeader));
+    h->ft_bias_offset = offset;
+    offset = align64(offset + NNUE_HALF * sizeof(int16_t));
+    h->ft_weights_offset = offset;
+    offset = align64(offset + (uint32_t)NNUE_INPUTS * NNUE_HALF * sizeof(int16_t));
+    h->ft_psqt_offset = offset;
+    offset = align64(offset + NNUE_INPUTS * sizeof(int32_t));
+    h->l1_bias_offset = offset;
+    offset = align64(offset + NNUE_L1 * sizeof(int32_t));
+    h->l1_weights_offset = offset;
+    offset = align64(offset + NNUE_L1 * 2 * NNUE_HALF);
+    h->l2_bias_offset = offset;
+    offset = align64(offset + NNUE_L2 * sizeof(int32_t));
+    h->l2_weights_offset = offset;
+    offset = align64(offset + NNUE_L2 * NNUE_L1);
+    h->out_bias_offset = offset;
+    offset = align64(offset + sizeof(int32_t));
+    h->out_weights_offset = offset;
+    offset = align64(offset + NNUE_L2);
+    h->file_size = offset;
+    return offset;
+}
+
+bool nnue_load(const char* path) {
+#ifdef _WIN32
+    (void)path;
+    return false;
+#else
+    const int fd = open(path, O_RDONLY);
+    if (fd < 0) return false;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(NnueHeader)) {
+        close(fd);
+        return false;
+    }
+
+    void* map = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) return false;
+
+    // Every offset is a function of the layer sizes, so a matching layout validates them all.
+    NnueHeader expected;
+    layout(&expected);
+    const NnueHeader* header = map;
+    if (memcmp(header, &expected, sizeof(expected)) != 0 || (size_t)st.st_size < header->file_size) {
+        munmap(map, (size_t)st.st_size);
+        return false;
+    }
+
+    const char* base = map;
+    net.ft_bias = (const int16_t*)(base + header->ft_bias_offset);
+    net.ft_weights = (const int16_t*)(base + header->ft_weights_offset);
+    net.ft_psqt = (const int32_t*)(base + header->ft_psqt_offset);
+    net.l1_bias = (const int32_t*)(base + header->l1_bias_offset);
+    net.l1_weights = (const int8_t*)(base + header->l1_weights_offset);
+    net.l2_bias = (const int32_t*)(base + header->l2_bias_offset);
+    net.l2_weights = (const int8_t*)(base + header->l2_weights_offset);
+    net.out_bias = (const int32_t*)(base + header->out_bias_offset);
+    net.out_weights = (const int8_t*)(base + header->out_weights_offset);
+    loaded = true;
+    return true;
+#endif
+}
+
+bool nnue_enabled(void) {
+    return loaded;
+}
+
+void init_nnue(void) {
+    nnue_use_avx2(true);
+    const char* path = getenv("CHESS_NNUE");
+    if (path && !nnue_load(path)) {
+        fprintf(stderr, "Cannot load network %s, using the handcrafted evaluation\n", path);
+    }
+}
+
+// xorshift64*
+static uint64_t next_random(uint64_t* state) {
+    *state ^= *state >> 12;
+    *state ^= *state << 25;
+    *state ^= *state >> 27;
+    return *state * 0x2545F4914F6CDD1DULL;
+}
+
+static int8_t random_weight(uint64_t* state, const int range) {
+    return (int8_t)((int)((next_random(state) >> 33) % (uint64_t)(2 * range + 1)) - range);
+}
+
+static bool write_section(FILE* f, const uint32_t offset, const void* data, const size_t size) {
+    return fseek(f, offset, SEEK_SET) == 0 && fwrite(data, 1, size, f) == size;
+}
+
+bool nnue_export(const char* path) {
+    NnueHeader header;
+    const uint32_t size = layout(&header);
+    FILE* f = fopen(path, "wb");
+    if (!f) return false;
+
+    uint64_t state = 0x3C6EF372FE94F82BULL;
+    bool ok = write_section(f, 0, &header, sizeof(header));
+
+    int16_t ft_bias[NNUE_HALF] = {0};
+    ok = ok && write_section(f, header.ft_bias_offset, ft_bias, sizeof(ft_bias));
+
+    int16_t row[NNUE_HALF];
+    ok = ok && fseek(f, header.ft_weights_offset, SEEK_SET) == 0;
+    for (int i = 0; ok && i < NNUE_INPUTS; i++) {
+        for (int k = 0; k < NNUE_HALF; k++) row[k] = random_weight(&state, 8);
+        ok = fwrite(row, sizeof(row), 1, f) == 1;
+    }
+
+    // psqt: the piece's midgame value and square bonus as seen by the perspective,
+    // so (psqt[us] - psqt[them]) / 2 is the side to move's midgame PSQ score. The
+    // tables are mirror images, so White's perspective defines every feature.
+    int32_t* psqt = malloc(NNUE_INPUTS * sizeof(int32_t));
+    if (!psqt) {
+        fclose(f);
+        return false;
+    }
+    for (int king_sq = 0; king_sq < 64; king_sq++) {
+        for (int index = 0; index < 12; index++) {
+            if (INDEX_TYPE(index) == INDEX_KING) continue;
+            for (int sq = 0; sq < 64; sq++) {
+                psqt[feature(WHITE, king_sq, index, sq)] = PSQ_MG[index][sq];
+            }
+        }
+    }
+    ok = ok && write_section(f, header.ft_psqt_offset, psqt, NNUE_INPUTS * sizeof(int32_t));
+    free(psqt);
+
+    int32_t l1_bias[NNUE_L1], l2_bias[NNUE_L2], out_bias = 0;
+    int8_t l1_weights[NNUE_L1 * 2 * NNUE_HALF], l2_weights[NNUE_L2 * NNUE_L1], out_weights[NNUE_L2] = {0};
+    for (int j = 0; j < NNUE_L1; j++) l1_bias[j] = random_weight(&state, 64);
+    for (int j = 0; j < NNUE_L2; j++) l2_bias[j] = random_weight(&state, 64);
+    for (size_t i = 0; i < sizeof(l1_weights); i++) l1_weights[i] = random_weight(&state, 16);
+    for (size_t i = 0; i < sizeof(l2_weights); i++) l2_weights[i] = random_weight(&state, 32);
+    ok = ok && write_section(f, header.l1_bias_offset, l1_bias, sizeof(l1_bias))
+            && write_section(f, header.l1_weights_offset, l1_weights, sizeof(l1_weights))
+            && write_section(f, header.l2_bias_offset, l2_bias, sizeof(l2_bias))
+            && write_section(f, header.l2_weights_offset, l2_weights, sizeof(l2_weights))
+            && write_section(f, header.out_bias_offset, &out_bias, sizeof(out_bias))
+            && write_section(f, header.out_weights_offset, out_weights, sizeof(out_weights));
+
+    // Pad to the full size so the last section is covered by the mapping.
+    const uint8_t zero = 0;
+    ok = ok && write_section(f, size - 1, &zero, 1);
+    return fclose(f) == 0 && ok;
+}
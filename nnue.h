@@ -0,0 +1,119 @@
+//
+// Created by lenovo on 10/18/2026.
+//
+
+#ifndef NNUE_H
+#define NNUE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "constants.h"
+#include "bitboard.h"
+
+// === Network ===
+// HalfKP feature transformer: for each perspective, one input per (own king square,
+// non-king piece, square) with both squares mirrored vertically for Black, feeding
+// NNUE_HALF int16 accumulator values plus a direct material/PST term (psqt). The two
+// clipped halves, side to move first, go through two int8 layers to one output:
+//   eval = (psqt[us] - psqt[them]) / 2 + output / NNUE_OUTPUT_SCALE
+#define NNUE_PIECE_SQUARES  640         // own and their P, N, B, R, Q on 64 squares
+#define NNUE_INPUTS         (64 * NNUE_PIECE_SQUARES)
+#define NNUE_HALF           256
+#define NNUE_L1             32
+#define NNUE_L2             32
+#define NNUE_SHIFT          6           // hidden layers: (sum >> NNUE_SHIFT) clipped to [0, 127]
+#define NNUE_OUTPUT_SCALE   16
+#define NNUE_MAX_CHANGES    4           // feature changes one move can cause: capture + promotion
+
+// === Weight file ===
+// Written by `chess nnue-export`, mapped read-only and used in place, in host byte
+// order. Every section starts on a cache line:
+//   ft_bias     int16[NNUE_HALF]               ft_weights  int16[NNUE_INPUTS][NNUE_HALF]
+//   ft_psqt     int32[NNUE_INPUTS]
+//   l1_bias     int32[NNUE_L1]                 l1_weights  int8[NNUE_L1][2 * NNUE_HALF]
+//   l2_bias     int32[NNUE_L2]                 l2_weights  int8[NNUE_L2][NNUE_L1]
+//   out_bias    int32[1]                       out_weights int8[NNUE_L2]
+#define NNUE_PATH      "bin/nnue.bin"
+#define NNUE_TAG       "CHESSNN1"
+#define NNUE_VERSION   1
+#define NNUE_ENDIAN    0x01020304U
+
+typedef struct {
+    char tag[8];
+    uint32_t version;
+    uint32_t endian;            // NNUE_ENDIAN as written
+    uint32_t header_size;       // sizeof(NnueHeader)
+    uint32_t inputs, half, l1, l2;
+    uint32_t ft_bias_offset, ft_weights_offset, ft_psqt_offset;
+    uint32_t l1_bias_offset, l1_weights_offset;
+    uint32_t l2_bias_offset, l2_weights_offset;
+    uint32_t out_bias_offset, out_weights_offset;
+    uint32_t file_size;
+} NnueHeader;
+
+// === Accumulator stack ===
+// One entry per ply. make_move pushes (Bitboard.nnue++) and records the feature
+// changes as add_piece/remove_piece fire; unmake_move pops, so undoing a move costs
+// a pointer decrement. Entries are brought up to date lazily, at evaluation, from
+// the nearest computed entry below, or refreshed from the board when that
+// perspective's king has moved since.
+typedef struct {
+    int8_t index;               // piece index 0-11
+    uint8_t sq;
+    int8_t sign;                // +1 added, -1 removed
+} NnueChange;
+
+typedef struct NnueAccumulator {
+    int16_t values[2][NNUE_HALF];       // by perspective, WHITE / BLACK
+    int32_t psqt[2];
+    NnueChange changes[NNUE_MAX_CHANGES];
+    uint8_t change_count;
+    bool computed[2];
+    bool king_moved[2];
+} NnueAccumulator;
+
+static inline void nnue_push(Bitboard* b) {
+    NnueAccumulator* acc = ++b->nnue;
+    acc->change_count = 0;
+    acc->computed[WHITE] = acc->computed[BLACK] = false;
+    acc->king_moved[WHITE] = acc->king_moved[BLACK] = false;
+}
+
+// Kings are not features: a king move instead invalidates its own perspective.
+static inline void nnue_record(NnueAccumulator* acc, int index, int sq, int sign) {
+    if (INDEX_TYPE(index) == INDEX_KING) {
+        acc->king_moved[INDEX_SIDE(index)] = true;
+        return;
+    }
+    acc->changes[acc->change_count++] = (NnueChange){(int8_t)index, (uint8_t)sq, (int8_t)sign};
+}
+
+// Maps the weight file (CHESS_NNUE, if set) and selects the kernels. Without one,
+// evaluate_position stays handcrafted. Call once at startup.
+void init_nnue(void);
+
+// Maps `path` read-only and makes it the network. Returns false, changing nothing,
+// if the file is missing or its header doesn't match this build.
+bool nnue_load(const char* path);
+bool nnue_enabled(void);
+
+// AVX2 kernels where the CPU has them, scalar otherwise. Returns false, changing
+// nothing, if AVX2 is requested but unavailable.
+bool nnue_use_avx2(bool avx2);
+bool nnue_avx2(void);
+
+// Makes stack[0] the root accumulator of `b`, computed from scratch, and points
+// b->nnue at it. The stack needs one entry per ply searched beyond the root.
+void nnue_attach(Bitboard* b, NnueAccumulator* stack);
+
+// Network output in centipawns from the side to move's point of view. Updates the
+// accumulators b->nnue depends on first.
+int nnue_evaluate(const Bitboard* b);
+
+// Writes a network whose psqt term reproduces the midgame material + piece-square
+// score (less the king's squares) and whose hidden layers are fixed pseudo-random
+// weights feeding a zero output. No trained network ships with the engine; this one
+// exercises the whole pipeline and can be checked against the handcrafted eval.
+bool nnue_export(const char* path);
+
+#endif //NNUE_H
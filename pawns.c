@@ -0,0 +1,129 @@
+//
+// Created by lenovo on 10/18/2026.
+//
+#include <stdint.h>
+#include "constants.h"
+#include "bitboard.h"
+#include "pawns.h"
+#include "utils.h"
+
+#define DOUBLED_MG   -10
+#define DOUBLED_EG   -20
+#define ISOLATED_MG  -10
+#define ISOLATED_EG  -15
+#define BACKWARD_MG   -8
+#define BACKWARD_EG  -10
+#define SHIELD_NEAR   15            // shield pawn one rank in front of the king
+#define SHIELD_FAR     8            // two ranks in front
+
+// By rank relative to the pawn's side.
+static const int PASSED_MG[8] = {0, 5, 10, 15, 25, 40, 60, 0};
+static const int PASSED_EG[8] = {0, 10, 20, 35, 60, 90, 130, 0};
+static const int PASSED_FREE[8] = {0, 0, 5, 10, 20, 35, 60, 0};
+
+static inline uint64_t fill_north(uint64_t b) {
+    b |= b << 8;
+    b |= b << 16;
+    b |= b << 32;
+    return b;
+}
+
+static inline uint64_t fill_south(uint64_t b) {
+    b |= b >> 8;
+    b |= b >> 16;
+    b |= b >> 32;
+    return b;
+}
+
+static inline uint64_t adjacent_files(const uint64_t b) {
+    return ((b & NOT_FILE_A) >> 1) | ((b & NOT_FILE_H) << 1);
+}
+
+// Squares strictly in front of `b` from `side`'s point of view.
+static inline uint64_t front_span(const int side, const uint64_t b) {
+    return side == WHITE ? fill_north(b << 8) : fill_south(b >> 8);
+}
+
+static inline uint64_t push(const int side, const uint64_t b) {
+    return side == WHITE ? b << 8 : b >> 8;
+}
+
+void pawn_evaluate(const Bitboard* b, PawnEntry* e) {
+    e->key = b->pawn_key;
+    e->mg = e->eg = 0;
+    for (int side = WHITE; side <= BLACK; side++) {
+        e->attacks[side] = generate_pawn_attack_mask(b->pieces[INDEX_OF(side, INDEX_PAWN)], side == WHITE);
+        e->attack_span[side] = front_span(side, adjacent_files(b->pieces[INDEX_OF(side, INDEX_PAWN)]));
+        e->king_sq[side] = 0xFF;
+    }
+
+    for (int side = WHITE; side <= BLACK; side++) {
+        const int them = !side;
+        const int sign = side == WHITE ? 1 : -1;
+        const uint64_t pawns = b->pieces[INDEX_OF(side, INDEX_PAWN)];
+        const uint64_t their_pawns = b->pieces[INDEX_OF(them, INDEX_PAWN)];
+
+        // Not passed: an enemy pawn ahead on the same file, or one that can still take it.
+        e->passed[side] = pawns & ~(front_span(them, their_pawns) | e->attack_span[them]);
+        const uint64_t doubled = pawns & front_span(them, pawns);
+        const uint64_t isolated = pawns & ~adjacent_files(fill_north(fill_south(pawns)));
+        // Can't be defended by a pawn and its stop square is attacked.
+        const uint64_t backward = pawns & ~isolated & ~(e->attack_span[side] | adjacent_files(pawns)) &
+                                  push(them, e->attacks[them]);
+
+        int mg = popcount(doubled) * DOUBLED_MG + popcount(isolated) * ISOLATED_MG + popcount(backward) * BACKWARD_MG;
+        int eg = popcount(doubled) * DOUBLED_EG + popcount(isolated) * ISOLATED_EG + popcount(backward) * BACKWARD_EG;
+        uint64_t passed = e->passed[side];
+        while (passed) {
+            const int sq = pop_lsb(&passed);
+            const int rank = side == WHITE ? sq >> 3 : 7 - (sq >> 3);
+            mg += PASSED_MG[rank];
+            eg += PASSED_EG[rank];
+        }
+        e->mg = (int16_t)(e->mg + sign * mg);
+        e->eg = (int16_t)(e->eg + sign * eg);
+    }
+}
+
+PawnEntry* pawn_probe(PawnTable* table, const Bitboard* b) {
+    PawnEntry* e = &table->entries[b->pawn_key & (PAWN_HASH_SIZE - 1)];
+    table->probes++;
+    if (e->key == b->pawn_key) {
+        table->hits++;
+        return e;
+    }
+    pawn_evaluate(b, e);
+    return e;
+}
+
+int pawn_shelter(PawnEntry* e, const Bitboard* b, const int side) {
+    const int king_sq = lsb(b->pieces[INDEX_OF(side, INDEX_KING)]);
+    if (e->king_sq[side] == king_sq) return e->shelter[side];
+
+    // Pawns on the two ranks in front of the king, on its file and the neighbouring
+    // ones, with the king kept off the edge files.
+    int file = king_sq & 7;
+    file = file < 1 ? 1 : file > 6 ? 6 : file;
+    const uint64_t pawns = b->pieces[INDEX_OF(side, INDEX_PAWN)] & (MASK_FILE_A * (7ULL << (file - 1)));
+    const uint64_t near = push(side, MASK_RANK_1 << (king_sq & 56));
+    const uint64_t far = push(side, near);
+    const int shelter = popcount(pawns & near) * SHIELD_NEAR + popcount(pawns & far) * SHIELD_FAR;
+
+    e->king_sq[side] = (uint8_t)king_sq;
+    e->shelter[side] = (int16_t)shelter;
+    return shelter;
+}
+
+int passed_free_path(const PawnEntry* e, const Bitboard* b) {
+    int score = 0;
+    for (int side = WHITE; side <= BLACK; side++) {
+        uint64_t passed = e->passed[side];
+        while (passed) {
+            const int sq = pop_lsb(&passed);
+            if (front_span(side, 1ULL << sq) & b->all_occupancy) continue;
+            const int rank = side == WHITE ? sq >> 3 : 7 - (sq >> 3);
+            score += side == WHITE ? PASSED_FREE[rank] : -PASSED_FREE[rank];
+        }
+    }
+    return score;
+}
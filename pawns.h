@@ -0,0 +1,46 @@
+//
+// Created by lenovo on 10/18/2026.
+//
+
+#ifndef PAWNS_H
+#define PAWNS_H
+
+#include <stdint.h>
+#include "bitboard.h"
+
+#define PAWN_HASH_SIZE 16384        // entries per table, power of two
+
+// Everything the evaluator needs that depends on the pawns alone, by side.
+// Scores are from White's point of view.
+typedef struct {
+    uint64_t key;                   // Bitboard.pawn_key
+    uint64_t passed[2];
+    uint64_t attacks[2];            // squares attacked by pawns now
+    uint64_t attack_span[2];        // squares pawns could attack as they advance
+    int16_t mg, eg;                 // doubled, isolated, backward and passed pawns
+    int16_t shelter[2];             // pawn shield in front of king_sq[side], midgame only
+    uint8_t king_sq[2];             // shelter is only valid for these king squares
+} PawnEntry;
+
+// One per search thread, so it needs no locking. Always replaces: pawn structures
+// change rarely along a search path, so the latest is the one worth keeping.
+typedef struct {
+    PawnEntry entries[PAWN_HASH_SIZE];
+    uint64_t probes;
+    uint64_t hits;
+} PawnTable;
+
+// The entry for b's pawns, evaluated and stored on a miss.
+PawnEntry* pawn_probe(PawnTable* table, const Bitboard* b);
+
+// Evaluates b's pawns into `entry` without any table.
+void pawn_evaluate(const Bitboard* b, PawnEntry* entry);
+
+// Shield score of `side`'s pawns for its king where it stands now, cached in the entry.
+int pawn_shelter(PawnEntry* entry, const Bitboard* b, int side);
+
+// Endgame bonus, from White's point of view, for passed pawns with no piece on the
+// way to promotion. Depends on the pieces too, so it is never cached.
+int passed_free_path(const PawnEntry* entry, const Bitboard* b);
+
+#endif //PAWNS_H
@@ -0,0 +1,294 @@
+//
+// Created by lenovo on 10/18/2026.
+//
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+#include <string.h>
+#include "constants.h"
+#include "bitboard.h"
+#include "move.h"
+#include "movegeneration.h"
+#include "perft.h"
+#include "threadpool.h"
+#include "utils.h"
+
+uint64_t perft(Bitboard* b, const int depth) {
+    MoveList list;
+    list.count = 0;
+    generate_legal_moves(b, &list);
+
+    if (depth <= 1) return depth == 1 ? list.count : 1;
+
+    uint64_t nodes = 0;
+    Undo u;
+    for (size_t i = 0; i < list.count; i++) {
+        make_move(b, list.moves[i], &u);
+        nodes += perft(b, depth - 1);
+        unmake_move(b, list.moves[i], &u);
+    }
+    return nodes;
+}
+
+uint64_t perft_copy(const Bitboard b, const int depth) {
+    MoveList list;
+    list.count = 0;
+    generate_legal_moves(&b, &list);
+
+    if (depth <= 1) return depth == 1 ? list.count : 1;
+
+    uint64_t nodes = 0;
+    for (size_t i = 0; i < list.count; i++) {
+        nodes += perft_copy(MakeMove(list.moves[i], b), depth - 1);
+    }
+    return nodes;
+}
+
+static void print_rate(const uint64_t nodes, const uint64_t elapsed_ns) {
+    const double seconds = (double)elapsed_ns / 1e9;
+    printf("Nodes: %llu  Time: %.3f s  NPS: %.0f\n",
+           (unsigned long long)nodes, seconds, seconds > 0 ? (double)nodes / seconds : 0.0);
+}
+
+uint64_t perft_divide(Bitboard* b, const int depth) {
+    MoveList list;
+    list.count = 0;
+    generate_legal_moves(b, &list);
+
+    const uint64_t start = time_now_ns();
+    uint64_t total = 0;
+    Undo u;
+    char name[6];
+    for (size_t i = 0; i < list.count; i++) {
+        make_move(b, list.moves[i], &u);
+        const uint64_t nodes = depth > 1 ? perft(b, depth - 1) : 1;
+        unmake_move(b, list.moves[i], &u);
+
+        move_to_string(list.moves[i], name);
+        printf("%s: %llu\n", name, (unsigned long long)nodes);
+        total += nodes;
+    }
+    printf("\nMoves: %zu\n", list.count);
+    print_rate(total, time_now_ns() - start);
+    return total;
+}
+
+// --- Standard suite ---
+
+#define PERFT_SUITE_MAX_DEPTH 6
+
+typedef struct {
+    const char* name;
+    const char* fen;
+    int default_depth;
+    uint64_t expected[PERFT_SUITE_MAX_DEPTH];   // expected[d - 1] = perft(d), 0 = unknown
+} PerftCase;
+
+static const PerftCase PERFT_SUITE[] = {
+    {"startpos", "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1", 5,
+        {20, 400, 8902, 197281, 4865609, 119060324}},
+    {"kiwipete", "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1", 4,
+        {48, 2039, 97862, 4085603, 193690690, 8031647685ULL}},
+    {"position3", "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1", 5,
+        {14, 191, 2812, 43238, 674624, 11030083}},
+    {"position4", "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1", 4,
+        {6, 264, 9467, 422333, 15833292, 706045033}},
+    {"position4-mirrored", "r2q1rk1/pP1p2pp/Q4n2/bbp1p3/Np6/1B3NBn/pPPP1PPP/R3K2R b KQ - 0 1", 4,
+        {6, 264, 9467, 422333, 15833292, 706045033}},
+    {"position5", "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8", 4,
+        {44, 1486, 62379, 2103487, 89941194, 3048196529ULL}},
+    {"position6", "r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10", 4,
+        {46, 2079, 89890, 3894594, 164075551, 6923051137ULL}},
+};
+
+int perft_suite(const int max_depth) {
+    int failures = 0;
+    uint64_t total_nodes = 0;
+    const uint64_t suite_start = time_now_ns();
+
+    for (size_t i = 0; i < sizeof(PERFT_SUITE) / sizeof(PERFT_SUITE[0]); i++) {
+        const PerftCase* c = &PERFT_SUITE[i];
+        int depth = max_depth > 0 ? max_depth : c->default_depth;
+        while (depth > 1 && (depth > PERFT_SUITE_MAX_DEPTH || c->expected[depth - 1] == 0)) depth--;
+
+        Bitboard b = init_Bitboard(c->fen);
+        const uint64_t start = time_now_ns();
+        const uint64_t nodes = perft(&b, depth);
+        const uint64_t elapsed = time_now_ns() - start;
+        const bool ok = nodes == c->expected[depth - 1];
+
+        printf("%-20s depth %d: %12llu %s  (%.0f nps)\n", c->name, depth, (unsigned long long)nodes,
+               ok ? "ok" : "FAIL", elapsed ? (double)nodes * 1e9 / (double)elapsed : 0.0);
+        if (!ok) {
+            printf("    expected %llu\n", (unsigned long long)c->expected[depth - 1]);
+            failures++;
+        }
+        total_nodes += nodes;
+    }
+
+    printf("\n");
+    print_rate(total_nodes, time_now_ns() - suite_start);
+    printf("%d failure(s)\n", failures);
+    return failures;
+}
+
+// --- Parallel perft ---
+
+// Lockless shared hash: `check` holds key ^ nodes, so a slot torn by two threads
+// writing at once fails verification and reads as a miss instead of a wrong count.
+typedef struct {
+    _Atomic uint64_t check;
+    _Atomic uint64_t nodes;
+} PerftHashEntry;
+
+typedef struct {
+    _Alignas(64) uint64_t leaves;
+    uint64_t probes;
+    uint64_t hits;
+    uint64_t busy_ns;
+} PerftWorkerStats;
+
+typedef struct {
+    move16 root_move;
+    move16 reply;
+    uint16_t root_index;
+} PerftTask;
+
+typedef struct {
+    Bitboard root;
+    int depth;
+    PerftTask* tasks;
+    _Atomic uint64_t* root_counts;
+    PerftHashEntry* hash;
+    uint64_t hash_mask;
+    PerftWorkerStats* stats;
+} PerftJob;
+
+static uint64_t perft_hashed(Bitboard* b, const int depth, const PerftJob* job, PerftWorkerStats* st) {
+    MoveList list;
+    list.count = 0;
+    generate_legal_moves(b, &list);
+    if (depth <= 1) return depth == 1 ? list.count : 1;
+
+    const uint64_t key = b->key ^ (0xD6E8FEB86659FD93ULL * (uint64_t)depth);
+    PerftHashEntry* e = &job->hash[key & job->hash_mask];
+    st->probes++;
+    const uint64_t check = atomic_load_explicit(&e->check, memory_order_relaxed);
+    const uint64_t cached = atomic_load_explicit(&e->nodes, memory_order_relaxed);
+    if ((check ^ cached) == key) {
+        st->hits++;
+        return cached;
+    }
+
+    uint64_t nodes = 0;
+    Undo u;
+    for (size_t i = 0; i < list.count; i++) {
+        make_move(b, list.moves[i], &u);
+        nodes += perft_hashed(b, depth - 1, job, st);
+        unmake_move(b, list.moves[i], &u);
+    }
+
+    atomic_store_explicit(&e->nodes, nodes, memory_order_relaxed);
+    atomic_store_explicit(&e->check, key ^ nodes, memory_order_relaxed);
+    return nodes;
+}
+
+static void perft_task(void* context, const size_t index, const int worker) {
+    const PerftJob* job = context;
+    const PerftTask* t = &job->tasks[index];
+    PerftWorkerStats* st = &job->stats[worker];
+    const uint64_t start = time_now_ns();
+
+    Bitboard b = job->root;
+    Undo u;
+    make_move(&b, t->root_move, &u);
+    make_move(&b, t->reply, &u);
+    const uint64_t nodes = perft_hashed(&b, job->depth - 2, job, st);
+
+    atomic_fetch_add_explicit(&job->root_counts[t->root_index], nodes, memory_order_relaxed);
+    st->leaves += nodes;
+    st->busy_ns += time_now_ns() - start;
+}
+
+uint64_t perft_parallel(const Bitboard* b, const int depth, int threads, const size_t hash_mb) {
+    if (threads < 1) threads = threadpool_cpu_count();
+    if (threads > THREADPOOL_MAX_WORKERS) threads = THREADPOOL_MAX_WORKERS;
+    // Too shallow to split two plies deep: a plain divide prints the same summary.
+    if (depth < 3) {
+        Bitboard copy = *b;
+        if (depth > 0) return perft_divide(&copy, depth);
+        print_rate(1, 0);
+        return 1;
+    }
+
+    PerftJob job;
+    job.root = *b;
+    job.depth = depth;
+
+    // Hash size rounded down to a power of two entries.
+    size_t entries = 1;
+    while (entries * 2 * sizeof(PerftHashEntry) <= hash_mb * 1024 * 1024) entries *= 2;
+    job.hash = calloc(entries, sizeof(PerftHashEntry));
+    job.hash_mask = entries - 1;
+    job.stats = aligned_alloc(64, sizeof(PerftWorkerStats) * (size_t)threads);
+
+    // Split the root and second ply into independent subtrees.
+    MoveList roots;
+    roots.count = 0;
+    generate_legal_moves(b, &roots);
+    job.tasks = malloc(sizeof(PerftTask) * roots.count * MAX_MOVES);
+    job.root_counts = calloc(roots.count ? roots.count : 1, sizeof(*job.root_counts));
+    if (!job.hash || !job.stats || !job.tasks || !job.root_counts) {
+        perror("perft_parallel");
+        exit(EXIT_FAILURE);
+    }
+    memset(job.stats, 0, sizeof(PerftWorkerStats) * (size_t)threads);
+
+    size_t tasks = 0;
+    for (size_t i = 0; i < roots.count; i++) {
+        Bitboard child = *b;
+        Undo u;
+        make_move(&child, roots.moves[i], &u);
+        MoveList replies;
+        replies.count = 0;
+        generate_legal_moves(&child, &replies);
+        for (size_t j = 0; j < replies.count; j++) {
+            job.tasks[tasks].root_move = roots.moves[i];
+            job.tasks[tasks].reply = replies.moves[j];
+            job.tasks[tasks].root_index = (uint16_t)i;
+            tasks++;
+        }
+    }
+
+    const uint64_t start = time_now_ns();
+    threadpool_run(threads, tasks, perft_task, &job);
+    const uint64_t elapsed = time_now_ns() - start;
+
+    uint64_t total = 0, probes = 0, hits = 0;
+    char name[6];
+    for (size_t i = 0; i < roots.count; i++) {
+        const uint64_t nodes = atomic_load(&job.root_counts[i]);
+        move_to_string(roots.moves[i], name);
+        printf("%s: %llu\n", name, (unsigned long long)nodes);
+        total += nodes;
+    }
+    printf("\n");
+    for (int t = 0; t < threads; t++) {
+        const PerftWorkerStats* st = &job.stats[t];
+        printf("thread %2d: %14llu leaves  %12.0f nps  (busy %.3f s)\n", t, (unsigned long long)st->leaves,
+               st->busy_ns ? (double)st->leaves * 1e9 / (double)st->busy_ns : 0.0, (double)st->busy_ns / 1e9);
+        probes += st->probes;
+        hits += st->hits;
+    }
+    printf("hash: %zu MB, %llu probes, %llu hits (%.1f%%)\n", (entries * sizeof(PerftHashEntry)) >> 20,
+           (unsigned long long)probes, (unsigned long long)hits, probes ? 100.0 * (double)hits / (double)probes : 0.0);
+    print_rate(total, elapsed);
+
+    free(job.hash);
+    free(job.stats);
+    free(job.tasks);
+    free(job.root_counts);
+    return total;
+}
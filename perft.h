@@ -0,0 +1,31 @@
+//
+// Created by lenovo on 10/18/2026.
+//
+
+#ifndef PERFT_H
+#define PERFT_H
+
+#include <stdint.h>
+#include "bitboard.h"
+
+// Leaf count with in-place make/unmake; depth-1 nodes are bulk counted from the
+// legal move list without making the moves.
+uint64_t perft(Bitboard* b, int depth);
+
+// Same tree walked with copy-make (MakeMove), to compare the two strategies.
+uint64_t perft_copy(Bitboard b, int depth);
+
+// Prints the leaf count under each root move, then the total and nodes/sec.
+uint64_t perft_divide(Bitboard* b, int depth);
+
+// Splits the root and second ply across `threads` workers (0 = all CPUs) that
+// share a lockless hash of `hash_mb` MB keyed by position and depth. Prints the
+// per-root-move counts, per-thread node rates and the hash hit ratio.
+uint64_t perft_parallel(const Bitboard* b, int depth, int threads, size_t hash_mb);
+
+// Runs the standard perft positions and checks them against known counts.
+// `max_depth` caps each position's depth (0 = the suite's default depths).
+// Returns the number of failing positions.
+int perft_suite(int max_depth);
+
+#endif //PERFT_H
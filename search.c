@@ -0,0 +1,685 @@
+//
+// Created by lenovo on 10/18/2026.
+//
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <math.h>
+#include "constants.h"
+#include "bitboard.h"
+#include "move.h"
+#include "movegeneration.h"
+#include "eval.h"
+#include "search.h"
+#include "tt.h"
+#include "utils.h"
+#include "threadpool.h"
+#include "nnue.h"
+#include "see.h"
+#include "timeman.h"
+
+#define LIMIT_CHECK_NODES 2048  // power of two: how often the clock and node limit are read
+
+// --- Parameters ---
+
+static int aspiration_depth = 5;    // first depth searched with a window around the last score
+static int aspiration_delta = 25;
+static int delta_margin = 200;      // qsearch: skip captures that can't lift stand-pat within this of alpha
+static int nmp_min_depth = 3;       // null move: R = nmp_reduction + depth / nmp_depth_divisor
+static int nmp_reduction = 3;
+static int nmp_depth_divisor = 4;
+static int lmr_min_depth = 3;       // late quiet moves, from move lmr_min_moves + 1 on, are reduced by
+static int lmr_min_moves = 3;       // lmr_base / 100 + ln(depth) * ln(move) * 100 / lmr_divisor plies
+static int lmr_base = 75;
+static int lmr_divisor = 225;
+static int move_overhead = 50;      // ms kept back from the clock for communication lag
+
+const SearchParam SEARCH_PARAMS[] = {
+    {"aspiration_depth", &aspiration_depth, 5, 1, MAX_PLY},
+    {"aspiration_delta", &aspiration_delta, 25, 1, 1000},
+    {"delta_margin", &delta_margin, 200, 0, 2000},
+    {"nmp_min_depth", &nmp_min_depth, 3, 1, MAX_PLY},
+    {"nmp_reduction", &nmp_reduction, 3, 0, 10},
+    {"nmp_depth_divisor", &nmp_depth_divisor, 4, 1, MAX_PLY},
+    {"lmr_min_depth", &lmr_min_depth, 3, 1, MAX_PLY},
+    {"lmr_min_moves", &lmr_min_moves, 3, 1, MAX_MOVES},
+    {"lmr_base", &lmr_base, 75, -500, 500},
+    {"lmr_divisor", &lmr_divisor, 225, 10, 2000},
+    {"move_overhead", &move_overhead, 50, 0, 5000},
+};
+const int SEARCH_PARAM_COUNT = sizeof(SEARCH_PARAMS) / sizeof(SEARCH_PARAMS[0]);
+
+// Plies to reduce the n-th move searched (from 1) at a given depth, before adjustments.
+static uint8_t REDUCTIONS[MAX_PLY][MAX_MOVES];
+
+static void init_reductions(void) {
+    for (int depth = 1; depth < MAX_PLY; depth++) {
+        for (int n = 1; n < MAX_MOVES; n++) {
+            const double r = lmr_base / 100.0 + log(depth) * log(n) * 100.0 / lmr_divisor;
+            REDUCTIONS[depth][n] = r <= 0 ? 0 : r >= MAX_PLY ? MAX_PLY - 1 : (uint8_t)r;
+        }
+    }
+}
+
+int search_get_param(const char* name) {
+    for (int i = 0; i < SEARCH_PARAM_COUNT; i++) {
+        if (strcmp(SEARCH_PARAMS[i].name, name) == 0) return *SEARCH_PARAMS[i].value;
+    }
+    return 0;
+}
+
+void init_search(void) {
+    init_reductions();
+}
+
+bool search_set_param(const char* name, const int value) {
+    for (int i = 0; i < SEARCH_PARAM_COUNT; i++) {
+        const SearchParam* p = &SEARCH_PARAMS[i];
+        if (strcmp(p->name, name) != 0) continue;
+        if (value < p->min || value > p->max) return false;
+        *p->value = value;
+        if (p->value == &lmr_base || p->value == &lmr_divisor) init_reductions();
+        return true;
+    }
+    return false;
+}
+
+atomic_bool SEARCH_STOP;
+atomic_bool SEARCH_PONDER;
+
+// --- Helpers ---
+
+// Mate scores are stored relative to the node, not the root, so a TT hit at a
+// different ply still reports the right distance to mate.
+static inline int score_to_tt(int score, int ply) {
+    if (score >= VALUE_MATE_IN_MAX_PLY) return score + ply;
+    if (score <= -VALUE_MATE_IN_MAX_PLY) return score - ply;
+    return score;
+}
+
+static inline int score_from_tt(int score, int ply) {
+    if (score >= VALUE_MATE_IN_MAX_PLY) return score - ply;
+    if (score <= -VALUE_MATE_IN_MAX_PLY) return score + ply;
+    return score;
+}
+
+static inline void do_move(SearchThread* t, int ply, move16 m) {
+    SearchFrame* f = &t->frames[ply];
+    f->move = m;
+    make_move(&t->board, m, &f->undo);
+    tt_prefetch(t->board.key);
+    t->keys[t->key_count++] = t->board.key;
+}
+
+static inline void undo_move(SearchThread* t, int ply) {
+    SearchFrame* f = &t->frames[ply];
+    t->key_count--;
+    unmake_move(&t->board, f->move, &f->undo);
+}
+
+// The frame's move stays MOVE_NONE, which the child reads as "reached by a null move".
+static inline void do_null_move(SearchThread* t, int ply) {
+    SearchFrame* f = &t->frames[ply];
+    f->move = MOVE_NONE;
+    make_null_move(&t->board, &f->undo);
+    tt_prefetch(t->board.key);
+    t->keys[t->key_count++] = t->board.key;
+}
+
+static inline void undo_null_move(SearchThread* t, int ply) {
+    t->key_count--;
+    unmake_null_move(&t->board, &t->frames[ply].undo);
+}
+
+// Zugzwang guard: with only pawns (and the king) left, passing can be the best move.
+static inline bool has_non_pawn_material(const Bitboard* b) {
+    const uint64_t* p = &b->pieces[INDEX_OF(MOVING, INDEX_PAWN)];
+    return (p[INDEX_KNIGHT] | p[INDEX_BISHOP] | p[INDEX_ROOK] | p[INDEX_QUEEN]) != 0;
+}
+
+// Fifty-move rule, or the current position already occurred since the last
+// irreversible move. One repetition is enough to score a draw inside the tree.
+static bool is_draw(const SearchThread* t) {
+    const Bitboard* b = &t->board;
+    if (b->halfmove_clock >= 100) return true;
+
+    const int current = t->key_count - 1;
+    const int oldest = current - b->halfmove_clock > 0 ? current - b->halfmove_clock : 0;
+    for (int i = current - 4; i >= oldest; i -= 2) {
+        if (t->keys[i] == b->key) return true;
+    }
+    return false;
+}
+
+static inline uint64_t thread_nodes(const SearchThread* t) {
+    return atomic_load_explicit(&t->nodes, memory_order_relaxed);
+}
+
+// Plain load and store: only the owner writes its counter, so no read-modify-write is needed.
+static inline uint64_t count_node(SearchThread* t) {
+    const uint64_t nodes = thread_nodes(t) + 1;
+    atomic_store_explicit(&t->nodes, nodes, memory_order_relaxed);
+    return nodes;
+}
+
+static uint64_t total_nodes(const SearchThread* t) {
+    uint64_t nodes = 0;
+    for (int i = 0; i < t->thread_count; i++) nodes += thread_nodes(t->threads[i]);
+    return nodes;
+}
+
+// Main thread only: helpers just follow the stop flag.
+static void check_limits(SearchThread* t) {
+    const SearchLimits* limits = t->limits;
+    if (t->id != 0) return;
+    // Pondering: the clock starts at the last check before ponderhit.
+    if (atomic_load_explicit(&SEARCH_PONDER, memory_order_relaxed)) {
+        t->start_ns = time_now_ns();
+        return;
+    }
+    if (limits->nodes && total_nodes(t) >= limits->nodes) {
+        atomic_store_explicit(t->stop, true, memory_order_relaxed);
+    }
+    if (time_hard_expired(&t->time, time_now_ns() - t->start_ns)) {
+        atomic_store_explicit(t->stop, true, memory_order_relaxed);
+    }
+}
+
+static inline bool stopped(const SearchThread* t) {
+    return atomic_load_explicit(t->stop, memory_order_relaxed);
+}
+
+#define MAX_QUIETS 64   // quiet moves remembered per node for the history malus
+
+// A quiet move cut off: make it a killer and the countermove of the previous
+// move, and reward it in the history at the expense of the quiets tried before it.
+static void update_quiet_stats(SearchThread* t, const int ply, const move16 m, const move16* quiets,
+                               const int quiet_count, const int depth) {
+    SearchFrame* f = &t->frames[ply];
+    if (f->killers[0] != m) {
+        f->killers[1] = f->killers[0];
+        f->killers[0] = m;
+    }
+
+    const int side = t->board.to_move;
+    const int bonus = depth * depth;
+    history_update(&t->history.butterfly[side][MOVE_FROM(m)][MOVE_TO(m)], bonus);
+    for (int i = 0; i < quiet_count; i++) {
+        history_update(&t->history.butterfly[side][MOVE_FROM(quiets[i])][MOVE_TO(quiets[i])], -bonus);
+    }
+
+    if (ply > 0 && t->frames[ply - 1].move != MOVE_NONE) {
+        const int prev_to = MOVE_TO(t->frames[ply - 1].move);
+        t->history.countermoves[piece_on(&t->board, prev_to)][prev_to] = m;
+    }
+}
+
+static inline void update_pv(SearchThread* t, int ply, move16 m) {
+    t->pv[ply][ply] = m;
+    for (int i = ply + 1; i < t->pv_length[ply + 1]; i++) t->pv[ply][i] = t->pv[ply + 1][i];
+    t->pv_length[ply] = t->pv_length[ply + 1];
+}
+
+// --- Quiescence search ---
+
+// The static eval, from the TT entry when an earlier visit stored one.
+static inline int static_eval(SearchThread* t, const Bitboard* b, const TTData* tte) {
+    if (tte && tte->eval != VALUE_NONE) return tte->eval;
+    return evaluate_position(b, &t->eval);
+}
+
+// Resolves captures until the position is quiet, so the static eval is never read in
+// the middle of an exchange. The side to move may stand pat on its eval; captures
+// that couldn't raise it to alpha even winning the piece outright (delta pruning),
+// or that lose material by SEE, are skipped. In check every evasion is searched.
+static int qsearch(SearchThread* t, int alpha, const int beta, const int ply) {
+    Bitboard* b = &t->board;
+    t->pv_length[ply] = ply;
+    t->qnodes++;
+    if ((count_node(t) & (LIMIT_CHECK_NODES - 1)) == 0) check_limits(t);
+    if (stopped(t)) return 0;
+    if (ply > t->seldepth) t->seldepth = ply;
+    if (is_draw(t)) return VALUE_DRAW;
+
+    const bool checked = in_check(b);
+    if (ply >= MAX_PLY - 1) return evaluate_position(b, &t->eval);
+
+    TTData tte;
+    const bool tt_hit = tt_probe(b->key, &tte);
+    if (tt_hit) {
+        const int score = score_from_tt(tte.score, ply);
+        if (tte.bound == BOUND_EXACT ||
+            (tte.bound == BOUND_LOWER && score >= beta) ||
+            (tte.bound == BOUND_UPPER && score <= alpha)) {
+            return score;
+        }
+    }
+
+    int stand_pat = -VALUE_INFINITE, best_score = -VALUE_INFINITE, eval = VALUE_NONE;
+    if (!checked) {
+        eval = stand_pat = best_score = static_eval(t, b, tt_hit ? &tte : NULL);
+        if (stand_pat >= beta) return stand_pat;
+        if (stand_pat > alpha) alpha = stand_pat;
+    }
+
+    SearchFrame* f = &t->frames[ply];
+    MoveList* list = &f->moves;
+    list->count = 0;
+    if (checked) {
+        generate_legal_moves(b, list);
+        if (list->count == 0) return -VALUE_MATE + ply;
+    } else {
+        generate_legal_captures(b, list);
+    }
+    static const move16 no_killers[2] = {MOVE_NONE, MOVE_NONE};
+    picker_init(&f->picker, b, list, tt_hit ? tte.move : MOVE_NONE, no_killers, MOVE_NONE, &t->history);
+
+    const int original_alpha = alpha;
+    move16 best_move = MOVE_NONE;
+    move16 m;
+    while ((m = picker_next(&f->picker)) != MOVE_NONE) {
+        if (!checked) {
+            const int to = MOVE_TO(m);
+            int gain = MOVE_FLAG(m) == MOVE_FLAG_ENPASSANT ? PIECE_VALUES[INDEX_PAWN]
+                     : (b->all_occupancy & (1ULL << to)) ? PIECE_VALUES[INDEX_TYPE(piece_on(b, to))] : 0;
+            if (IS_PROMO(m)) gain += PIECE_VALUES[INDEX_QUEEN] - PIECE_VALUES[INDEX_PAWN];
+            if (stand_pat + gain + delta_margin <= alpha) continue;
+            // The picker has already run SEE on every capture but the hash move.
+            if (picker_bad_capture(&f->picker) || (tt_hit && m == tte.move && !see_ge(b, m, 0))) continue;
+        }
+
+        do_move(t, ply, m);
+        const int score = -qsearch(t, -beta, -alpha, ply + 1);
+        undo_move(t, ply);
+        if (stopped(t)) return 0;
+
+        if (score > best_score) {
+            best_score = score;
+            if (score > alpha) {
+                best_move = m;
+                alpha = score;
+                update_pv(t, ply, m);
+                if (alpha >= beta) break;
+            }
+        }
+    }
+
+    const int bound = best_score >= beta ? BOUND_LOWER : best_score > original_alpha ? BOUND_EXACT : BOUND_UPPER;
+    tt_store(b->key, best_move, score_to_tt(best_score, ply), eval, 0, bound);
+    return best_score;
+}
+
+// --- Principal variation search ---
+
+static int search(SearchThread* t, int alpha, int beta, int depth, const int ply, const bool pv_node) {
+    Bitboard* b = &t->board;
+    t->pv_length[ply] = ply;
+    if ((count_node(t) & (LIMIT_CHECK_NODES - 1)) == 0) check_limits(t);
+    if (stopped(t)) return 0;
+    if (ply > t->seldepth) t->seldepth = ply;
+
+    if (ply > 0) {
+        if (is_draw(t)) return VALUE_DRAW;
+        // Mate distance pruning: no line from here can beat a mate already found nearer the root.
+        alpha = alpha > -VALUE_MATE + ply ? alpha : -VALUE_MATE + ply;
+        beta = beta < VALUE_MATE - ply - 1 ? beta : VALUE_MATE - ply - 1;
+        if (alpha >= beta) return alpha;
+    }
+
+    const bool checked = in_check(b);
+    if (checked && ply < MAX_PLY - 1) depth++;
+    if (depth <= 0 || ply >= MAX_PLY - 1) return qsearch(t, alpha, beta, ply);
+
+    TTData tte;
+    const bool tt_hit = tt_probe(b->key, &tte);
+    const move16 hash_move = tt_hit ? tte.move : MOVE_NONE;
+    if (tt_hit && !pv_node && tte.depth >= depth) {
+        const int score = score_from_tt(tte.score, ply);
+        if (tte.bound == BOUND_EXACT ||
+            (tte.bound == BOUND_LOWER && score >= beta) ||
+            (tte.bound == BOUND_UPPER && score <= alpha)) {
+            return score;
+        }
+    }
+
+    // The static eval comes free with a TT hit; otherwise it is only computed where
+    // null-move pruning needs it, and stored for the next visit.
+    int eval = tt_hit ? tte.eval : VALUE_NONE;
+
+    // Null move: if passing still fails high after a reduced search, a real move
+    // would too. Not twice in a row, not in check, not with only pawns.
+    if (!pv_node && !checked && ply > 0 && depth >= nmp_min_depth && t->frames[ply - 1].move != MOVE_NONE &&
+        beta > -VALUE_MATE_IN_MAX_PLY && has_non_pawn_material(b)) {
+        if (eval == VALUE_NONE) eval = evaluate_position(b, &t->eval);
+        if (eval >= beta) {
+            const int r = nmp_reduction + depth / nmp_depth_divisor;
+            do_null_move(t, ply);
+            const int score = -search(t, -beta, -beta + 1, depth - 1 - r, ply + 1, false);
+            undo_null_move(t, ply);
+            if (stopped(t)) return 0;
+            // An unproven mate found by passing isn't trusted.
+            if (score >= beta) return score >= VALUE_MATE_IN_MAX_PLY ? beta : score;
+        }
+    }
+
+    SearchFrame* f = &t->frames[ply];
+    MoveList* list = &f->moves;
+    list->count = 0;
+    generate_legal_moves(b, list);
+    if (list->count == 0) return checked ? -VALUE_MATE + ply : VALUE_DRAW;
+
+    move16 countermove = MOVE_NONE;
+    if (ply > 0 && t->frames[ply - 1].move != MOVE_NONE) {
+        const int prev_to = MOVE_TO(t->frames[ply - 1].move);
+        countermove = t->history.countermoves[piece_on(b, prev_to)][prev_to];
+    }
+    picker_init(&f->picker, b, list, hash_move, f->killers, countermove, &t->history);
+
+    const int original_alpha = alpha;
+    int best_score = -VALUE_INFINITE;
+    move16 best_move = MOVE_NONE;
+    move16 quiets[MAX_QUIETS];
+    int quiet_count = 0, moves_searched = 0;
+
+    move16 m;
+    while ((m = picker_next(&f->picker)) != MOVE_NONE) {
+        const bool quiet = !IS_CAPTURE(b, m) && !IS_PROMO(m);
+        const bool bad_capture = picker_bad_capture(&f->picker);
+        do_move(t, ply, m);
+
+        int score;
+        if (moves_searched++ == 0) {
+            score = -search(t, -beta, -alpha, depth - 1, ply + 1, pv_node);
+        } else {
+            // Later moves only need to be shown worse than the best so far, late quiet
+            // ones and losing captures at reduced depth. Re-search at full depth, then with the full
+            // window, if one unexpectedly isn't.
+            int r = 0;
+            if ((quiet || bad_capture) && !checked && depth >= lmr_min_depth && moves_searched > lmr_min_moves && !in_check(b)) {
+                r = REDUCTIONS[depth < MAX_PLY ? depth : MAX_PLY - 1][moves_searched];
+                if (pv_node) r--;
+                if (r > depth - 2) r = depth - 2;
+                if (r < 0) r = 0;
+            }
+            score = -search(t, -alpha - 1, -alpha, depth - 1 - r, ply + 1, false);
+            if (r > 0 && score > alpha) score = -search(t, -alpha - 1, -alpha, depth - 1, ply + 1, false);
+            if (score > alpha && score < beta) {
+                score = -search(t, -beta, -alpha, depth - 1, ply + 1, true);
+            }
+        }
+        undo_move(t, ply);
+        if (stopped(t)) return 0;
+
+        if (score > best_score) {
+            best_score = score;
+            if (score > alpha) {
+                best_move = m;
+                alpha = score;
+                update_pv(t, ply, m);
+                if (alpha >= beta) {
+                    t->cutoffs++;
+                    if (moves_searched == 1) t->first_move_cutoffs++;
+                    if (quiet) update_quiet_stats(t, ply, m, quiets, quiet_count, depth);
+                    break;
+                }
+            }
+        }
+        if (quiet && quiet_count < MAX_QUIETS) quiets[quiet_count++] = m;
+    }
+
+    const int bound = best_score >= beta ? BOUND_LOWER : best_score > original_alpha ? BOUND_EXACT : BOUND_UPPER;
+    tt_store(b->key, best_move ? best_move : hash_move, score_to_tt(best_score, ply), eval, depth, bound);
+    return best_score;
+}
+
+// --- Iterative deepening ---
+
+void format_score(const int score, char* out, const size_t size) {
+    if (score >= VALUE_MATE_IN_MAX_PLY) {
+        snprintf(out, size, "mate %d", (VALUE_MATE - score + 1) / 2);
+    } else if (score <= -VALUE_MATE_IN_MAX_PLY) {
+        snprintf(out, size, "mate %d", -(VALUE_MATE + score) / 2);
+    } else {
+        snprintf(out, size, "cp %d", score);
+    }
+}
+
+static void print_info(const SearchResult* r) {
+    char score[SCORE_STR_LEN], move[6];
+    format_score(r->score, score, sizeof(score));
+    const uint64_t ms = r->time_ns / 1000000ULL;
+    const uint64_t nps = r->time_ns ? r->nodes * 1000000000ULL / r->time_ns : 0;
+    printf("info depth %d seldepth %d score %s nodes %llu nps %llu time %llu hashfull %d pv", r->depth, r->seldepth,
+           score, (unsigned long long)r->nodes, (unsigned long long)nps, (unsigned long long)ms, tt_hashfull());
+    for (int i = 0; i < r->pv_length; i++) {
+        move_to_string(r->pv[i], move);
+        printf(" %s", move);
+    }
+    printf("\n");
+    fflush(stdout);
+}
+
+// Helper depth skipping: helper i searches only the depths where
+// ((depth + SKIP_PHASE[i]) / SKIP_SIZE[i]) is even, so the threads spread over
+// neighbouring depths instead of all repeating the same iteration.
+#define SKIP_PATTERNS 20
+static const int SKIP_SIZE[SKIP_PATTERNS]  = {1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 3, 3, 4, 4, 4, 4, 4, 4, 4, 4};
+static const int SKIP_PHASE[SKIP_PATTERNS] = {0, 1, 0, 1, 2, 3, 0, 1, 2, 3, 4, 5, 0, 1, 2, 3, 4, 5, 6, 7};
+
+typedef struct {
+    const Bitboard* root;
+    const uint64_t* history;
+    int history_count;
+    const SearchLimits* limits;
+    SearchResult* result;
+    uint64_t start_ns;
+} SearchJob;
+
+// Reused across searches so a search never allocates once it has started.
+static SearchThread* search_threads[MAX_SEARCH_THREADS];
+static size_t eval_cache_kb = EVAL_CACHE_DEFAULT_KB;
+
+void search_set_eval_cache(const size_t kb) {
+    eval_cache_kb = kb;
+}
+
+static void prepare_thread(SearchThread* t, const SearchJob* job, int thread_count) {
+    t->board = *job->root;
+    t->board.nnue = NULL;
+    if (nnue_enabled()) nnue_attach(&t->board, t->accumulators);
+    int history_count = job->history_count;
+    const uint64_t* history = job->history;
+    if (history_count > MAX_GAME_PLY) {
+        history += history_count - MAX_GAME_PLY;
+        history_count = MAX_GAME_PLY;
+    }
+    if (history_count > 0) memcpy(t->keys, history, (size_t)history_count * sizeof(uint64_t));
+    t->key_count = history_count;
+    t->keys[t->key_count++] = job->root->key;
+    atomic_store_explicit(&t->nodes, 0, memory_order_relaxed);
+    t->qnodes = 0;
+    t->seldepth = 0;
+    t->pawns.probes = t->pawns.hits = 0;
+    t->eval_cache.probes = t->eval_cache.hits = 0;
+    t->cutoffs = t->first_move_cutoffs = 0;
+    history_age(&t->history);
+    for (int ply = 0; ply <= MAX_PLY; ply++) t->frames[ply].killers[0] = t->frames[ply].killers[1] = MOVE_NONE;
+    t->limits = job->limits;
+    t->stop = &SEARCH_STOP;
+    t->start_ns = job->start_ns;
+    t->threads = search_threads;
+    t->thread_count = thread_count;
+}
+
+static void iterative_deepening(SearchThread* t, SearchResult* result) {
+    const SearchLimits* limits = t->limits;
+    const bool main = t->id == 0;
+    const int max_depth = limits->depth > 0 && limits->depth < MAX_PLY ? limits->depth : MAX_PLY - 1;
+    const int pattern = (t->id - 1) % SKIP_PATTERNS;
+    int score = 0;
+
+    for (int depth = 1; depth <= max_depth; depth++) {
+        if (!main && ((depth + SKIP_PHASE[pattern]) / SKIP_SIZE[pattern]) % 2) continue;
+
+        t->seldepth = 0;
+        int delta = aspiration_delta;
+        int alpha = -VALUE_INFINITE, beta = VALUE_INFINITE;
+        if (depth >= aspiration_depth) {
+            alpha = score - delta > -VALUE_INFINITE ? score - delta : -VALUE_INFINITE;
+            beta = score + delta < VALUE_INFINITE ? score + delta : VALUE_INFINITE;
+        }
+
+        // Aspiration: re-search with a doubled margin on the side that failed.
+        while (true) {
+            score = search(t, alpha, beta, depth, 0, true);
+            if (stopped(t)) break;
+            if (score <= alpha) {
+                beta = (alpha + beta) / 2;
+                alpha = score - delta > -VALUE_INFINITE ? score - delta : -VALUE_INFINITE;
+            } else if (score >= beta) {
+                beta = score + delta < VALUE_INFINITE ? score + delta : VALUE_INFINITE;
+            } else {
+                break;
+            }
+            delta *= 2;
+        }
+        if (stopped(t)) break;
+        if (!main) continue;
+
+        result->depth = depth;
+        result->seldepth = t->seldepth;
+        result->score = score;
+        result->pv_length = t->pv_length[0];
+        memcpy(result->pv, t->pv[0], (size_t)result->pv_length * sizeof(move16));
+        if (result->pv_length > 0) result->best_move = result->pv[0];
+        result->nodes = total_nodes(t);
+        result->time_ns = time_now_ns() - t->start_ns;
+        if (!limits->quiet) print_info(result);
+
+        // A forced mate found within this depth won't get shorter by searching deeper.
+        if (score >= VALUE_MATE_IN_MAX_PLY && VALUE_MATE - score <= depth) break;
+        // Past the soft deadline the next iteration would likely not finish. While
+        // pondering the clock isn't ours yet.
+        if (time_iteration_done(&t->time, result->best_move, score, time_now_ns() - t->start_ns) &&
+            !atomic_load_explicit(&SEARCH_PONDER, memory_order_relaxed)) {
+            break;
+        }
+    }
+
+    // The main thread decides when the search is over; helpers that run out of
+    // depths simply finish.
+    if (main) atomic_store(t->stop, true);
+}
+
+// Brings the thread's eval cache to the current EvalCache size.
+static void sync_eval_cache(SearchThread* t) {
+    EvalCache* cache = &t->eval_cache;
+    if ((cache->entries || cache->kb == 0) && cache->kb == eval_cache_kb) return;
+    if (!eval_cache_resize(cache, eval_cache_kb)) {
+        fprintf(stderr, "Failed to allocate a %zu KB eval cache, searching without\n", eval_cache_kb);
+    }
+}
+
+SearchThread* search_thread_create(void) {
+    // Zeroed: an all-zero pawn entry is the valid entry for pawn_key 0 (no pawns).
+    SearchThread* t = calloc(1, sizeof(SearchThread));
+    if (!t) {
+        fprintf(stderr, "Failed to allocate the search stack\n");
+        exit(EXIT_FAILURE);
+    }
+    t->eval.pawns = &t->pawns;
+    t->eval.cache = &t->eval_cache;
+    sync_eval_cache(t);
+    return t;
+}
+
+void search_thread_destroy(SearchThread* t) {
+    if (!t) return;
+    eval_cache_resize(&t->eval_cache, 0);
+    free(t);
+}
+
+int search_fixed_depth(SearchThread* t, const Bitboard* root, const int depth, move16* best_move) {
+    const SearchLimits limits = {.depth = depth, .quiet = true};
+    SearchResult result;
+    const SearchJob job = {root, NULL, 0, &limits, &result, time_now_ns()};
+    atomic_bool stop = false;
+    SearchThread* const self = t;
+
+    // A main thread of its own: its own stop flag, no helpers, no clock.
+    sync_eval_cache(t);
+    prepare_thread(t, &job, 1);
+    t->id = 0;
+    t->stop = &stop;
+    t->threads = &self;
+    time_init(&t->time, 0, 0, 0, 0, 0, 0);
+
+    memset(&result, 0, sizeof(result));
+    MoveList root_moves;
+    root_moves.count = 0;
+    generate_legal_moves(root, &root_moves);
+    if (root_moves.count == 0) {
+        *best_move = MOVE_NONE;
+        return in_check(root) ? -VALUE_MATE : VALUE_DRAW;
+    }
+    result.best_move = root_moves.moves[0];
+    iterative_deepening(t, &result);
+    *best_move = result.best_move;
+    return result.score;
+}
+
+static void search_worker(void* context, const size_t index, int worker) {
+    (void)worker;
+    const SearchJob* job = context;
+    SearchThread* t = search_threads[index];
+    iterative_deepening(t, job->result);
+}
+
+void search_position(const Bitboard* root, const uint64_t* history, int history_count,
+                     const SearchLimits* limits, SearchResult* result) {
+    int thread_count = limits->threads > 0 ? limits->threads : 1;
+    if (thread_count > MAX_SEARCH_THREADS) thread_count = MAX_SEARCH_THREADS;
+    for (int i = 0; i < thread_count; i++) {
+        if (!search_threads[i]) {
+            search_threads[i] = search_thread_create();
+            search_threads[i]->id = i;
+        }
+        sync_eval_cache(search_threads[i]);
+    }
+    if (!TT.buckets) tt_resize(16);
+    tt_new_search();
+
+    const SearchJob job = {root, history, history_count, limits, result, time_now_ns()};
+    for (int i = 0; i < thread_count; i++) prepare_thread(search_threads[i], &job, thread_count);
+
+    memset(result, 0, sizeof(*result));
+    MoveList root_moves;
+    root_moves.count = 0;
+    generate_legal_moves(root, &root_moves);
+    if (root_moves.count == 0) {
+        result->score = in_check(root) ? -VALUE_MATE : VALUE_DRAW;
+        atomic_store(&SEARCH_STOP, false);
+        return;
+    }
+    result->best_move = root_moves.moves[0];
+    time_init(&search_threads[0]->time, limits->movetime_ms, limits->time_ms, limits->inc_ms, limits->movestogo,
+              move_overhead, (int)root_moves.count);
+
+    // One task per thread; the calling thread runs task 0, the main search.
+    threadpool_run(thread_count, (size_t)thread_count, search_worker, (void*)&job);
+
+    atomic_store(&SEARCH_STOP, false);
+    result->nodes = total_nodes(search_threads[0]);
+    result->time_ns = time_now_ns() - job.start_ns;
+    for (int i = 0; i < thread_count; i++) {
+        result->qnodes += search_threads[i]->qnodes;
+        result->pawn_probes += search_threads[i]->pawns.probes;
+        result->pawn_hits += search_threads[i]->pawns.hits;
+        result->eval_probes += search_threads[i]->eval_cache.probes;
+        result->eval_hits += search_threads[i]->eval_cache.hits;
+        result->cutoffs += search_threads[i]->cutoffs;
+        result->first_move_cutoffs += search_threads[i]->first_move_cutoffs;
+    }
+}
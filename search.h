@@ -0,0 +1,162 @@
+//
+// Created by lenovo on 10/18/2026.
+//
+
+#ifndef SEARCH_H
+#define SEARCH_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+#include "bitboard.h"
+#include "move.h"
+#include "movegeneration.h"
+#include "nnue.h"
+#include "eval.h"
+#include "movepick.h"
+#include "timeman.h"
+
+#define MAX_PLY 128
+#define MAX_GAME_PLY 1024
+
+#define VALUE_DRAW      0
+#define VALUE_MATE      31000
+#define VALUE_INFINITE  32000
+#define VALUE_NONE      32001   // no static eval stored (in check, or never computed)
+#define VALUE_MATE_IN_MAX_PLY  (VALUE_MATE - MAX_PLY)
+
+typedef struct {
+    int depth;              // 0 = no limit (MAX_PLY - 1)
+    uint64_t nodes;         // 0 = no limit
+    uint64_t movetime_ms;   // 0 = no limit
+    uint64_t time_ms;       // side to move's clock, 0 = untimed
+    uint64_t inc_ms;        // its increment per move
+    int movestogo;          // moves to the next time control, 0 = rest of the game
+    int threads;            // Lazy SMP threads including the main one, 0 = 1
+    bool quiet;             // don't print an info line per iteration
+} SearchLimits;
+
+#define MAX_SEARCH_THREADS 256
+
+// One ply of the search stack. Frames live in the SearchThread, so the search itself
+// never allocates: each ply generates into its own frame's move list and keeps the
+// undo record for the move it is currently exploring.
+typedef struct {
+    MoveList moves;
+    MovePicker picker;
+    Undo undo;
+    move16 move;            // move made from this ply
+    move16 killers[2];      // quiet moves that last cut off at this ply, newest first
+} SearchFrame;
+
+// Everything one search thread owns, move-ordering history included. Lazy SMP
+// threads share nothing but the transposition table and the stop flag.
+typedef struct SearchThread {
+    int id;                 // 0 = main thread: reports, and watches the clock and node limit
+    Bitboard board;
+    SearchFrame frames[MAX_PLY + 1];
+
+    // Triangular PV: pv[ply] holds the best line from `ply`, pv_length[ply] its end.
+    move16 pv[MAX_PLY + 1][MAX_PLY + 1];
+    int pv_length[MAX_PLY + 1];
+
+    // Keys of the game before the root followed by the current search path, for
+    // repetition detection. keys[key_count - 1] is the current position.
+    uint64_t keys[MAX_GAME_PLY + MAX_PLY + 1];
+    int key_count;
+
+    // Written only by the owning thread; the main thread sums them for limits and reports.
+    _Atomic uint64_t nodes;
+    uint64_t qnodes;        // the part of `nodes` spent in quiescence search
+    int seldepth;
+
+    MoveHistory history;
+    uint64_t cutoffs;               // beta cutoffs, and how many came from the first move tried
+    uint64_t first_move_cutoffs;
+
+    PawnTable pawns;
+    EvalCache eval_cache;
+    EvalState eval;         // points at this thread's caches
+
+    // NNUE accumulators, one per ply, used when a network is loaded.
+    NnueAccumulator accumulators[MAX_PLY + 1];
+
+    const SearchLimits* limits;
+    uint64_t start_ns;
+    TimeManager time;       // main thread only
+    atomic_bool* stop;
+    struct SearchThread* const* threads;    // all threads of this search, [0] = main
+    int thread_count;
+} SearchThread;
+
+typedef struct {
+    move16 best_move;
+    int score;
+    int depth;              // last completed iteration
+    int seldepth;
+    uint64_t nodes;
+    uint64_t qnodes;        // of which in quiescence search, summed over all threads at the end
+    uint64_t time_ns;
+    uint64_t pawn_probes, pawn_hits;    // summed over all threads
+    uint64_t eval_probes, eval_hits;
+    uint64_t cutoffs, first_move_cutoffs;
+    move16 pv[MAX_PLY];
+    int pv_length;
+} SearchResult;
+
+// Search thresholds, tunable at runtime: `chess name=value ... <command>` on the
+// command line. Changing one while a search runs is not supported.
+typedef struct {
+    const char* name;
+    int* value;
+    int default_value, min, max;
+} SearchParam;
+
+extern const SearchParam SEARCH_PARAMS[];
+extern const int SEARCH_PARAM_COUNT;
+
+// False, changing nothing, for an unknown name or a value out of range.
+bool search_set_param(const char* name, int value);
+int search_get_param(const char* name);     // 0 for an unknown name
+
+// Builds the late-move reduction table. Call once at startup.
+void init_search(void);
+
+// Set to stop a running search; it returns the best move of the last completed
+// iteration. search_position clears it again before returning, so a stop that
+// can race with the end of a search must be cleared by its sender before the next.
+extern atomic_bool SEARCH_STOP;
+
+// While set the search ignores its time and node limits (UCI "go ponder"); clear
+// it on ponderhit and the limits apply from that moment.
+extern atomic_bool SEARCH_PONDER;
+
+// Iterative-deepening principal variation search from `root`. `history` holds the
+// keys of the positions before the root (oldest first, may be NULL) so repetitions
+// of the game are recognised. Prints a UCI-style info line per iteration unless
+// `limits->quiet`.
+//
+// With `limits->threads` > 1 this is Lazy SMP: helper threads search the same root
+// with staggered depths and feed each other through the transposition table. The
+// main thread alone checks the limits, reports, and stops the helpers when done.
+void search_position(const Bitboard* root, const uint64_t* history, int history_count,
+                     const SearchLimits* limits, SearchResult* result);
+
+// For many independent searches side by side (batch analysis): a search stack of
+// one's own, and a single-threaded fixed-depth search on it that prints nothing.
+// Calls on different threads share only the transposition table, which the
+// caller must have allocated (tt_resize).
+SearchThread* search_thread_create(void);
+void search_thread_destroy(SearchThread* t);
+int search_fixed_depth(SearchThread* t, const Bitboard* root, int depth, move16* best_move);
+
+// Static eval cache size per search thread, applied from the next search on.
+// 0 disables it. Not thread-safe: call while no search is running.
+void search_set_eval_cache(size_t kb);
+
+// Writes "cp N" or "mate N" for UCI output into `out`. SCORE_STR_LEN fits any int.
+#define SCORE_STR_LEN 24
+void format_score(int score, char* out, size_t size);
+
+#endif //SEARCH_H
@@ -0,0 +1,132 @@
+//
+// Created by lenovo on 10/18/2026.
+//
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include "constants.h"
+#include "bitboard.h"
+#include "move.h"
+#include "movegeneration.h"
+#include "attacks.h"
+#include "eval.h"
+#include "see.h"
+#include "utils.h"
+
+#define SEE_MAX_SWAPS 32
+
+static inline int see_value(const int type) {
+    return type == INDEX_KING ? SEE_KING_VALUE : PIECE_VALUES[type];
+}
+
+int see(const Bitboard* b, const move16 m) {
+    const int from = MOVE_FROM(m), to = MOVE_TO(m), flag = MOVE_FLAG(m);
+    if (flag == MOVE_FLAG_CASTLE) return 0;
+
+    const uint64_t* p = b->pieces;
+    const uint64_t diagonal = p[INDEX_WBISHOP] | p[INDEX_BBISHOP] | p[INDEX_WQUEEN] | p[INDEX_BQUEEN];
+    const uint64_t straight = p[INDEX_WROOK] | p[INDEX_BROOK] | p[INDEX_WQUEEN] | p[INDEX_BQUEEN];
+
+    // gain[d]: what the side making capture d wins if the sequence stops after it.
+    int gain[SEE_MAX_SWAPS];
+    int d = 0;
+    int attacker = INDEX_TYPE(piece_on(b, from));
+    uint64_t occupancy = b->all_occupancy ^ (1ULL << from);
+
+    if (flag == MOVE_FLAG_ENPASSANT) {
+        gain[0] = PIECE_VALUES[INDEX_PAWN];
+        occupancy ^= 1ULL << (to ^ 8);
+    } else {
+        gain[0] = (b->all_occupancy & (1ULL << to)) ? see_value(INDEX_TYPE(piece_on(b, to))) : 0;
+    }
+    if (flag == MOVE_FLAG_PROMOTION) {
+        attacker = MOVE_PROMO(m);
+        gain[0] += PIECE_VALUES[attacker] - PIECE_VALUES[INDEX_PAWN];
+    }
+
+    uint64_t attackers = attackers_to(b, to, occupancy) & occupancy;
+    int side = !b->to_move;
+
+    while (d < SEE_MAX_SWAPS - 1) {
+        const uint64_t own = attackers & (side == WHITE ? b->white_occupancy : b->black_occupancy);
+        if (!own) break;
+
+        // Least valuable attacker.
+        int type = INDEX_PAWN;
+        uint64_t candidates;
+        while (!(candidates = own & p[INDEX_OF(side, type)])) type++;
+        // A king can't capture onto a square the other side still attacks.
+        if (type == INDEX_KING && (attackers & ~own)) break;
+
+        d++;
+        gain[d] = see_value(attacker) - gain[d - 1];
+
+        occupancy ^= candidates & -candidates;
+        if (type == INDEX_PAWN || type == INDEX_BISHOP || type == INDEX_QUEEN) {
+            attackers |= bishop_attacks(to, occupancy) & diagonal;
+        }
+        if (type == INDEX_ROOK || type == INDEX_QUEEN) attackers |= rook_attacks(to, occupancy) & straight;
+        attackers &= occupancy;
+        attacker = type;
+        side = !side;
+    }
+
+    // Each side stops recapturing as soon as that is better than going on.
+    while (d > 0) {
+        gain[d - 1] = -(-gain[d - 1] > gain[d] ? -gain[d - 1] : gain[d]);
+        d--;
+    }
+    return gain[0];
+}
+
+// --- Known values ---
+
+typedef struct {
+    const char* fen;
+    const char* move;
+    int expected;
+} SeeCase;
+
+static const SeeCase SEE_SUITE[] = {
+    {"1k1r4/1pp4p/p7/4p3/8/P5P1/1PP4P/2K1R3 w - - 0 1", "e1e5", 100},                  // undefended pawn
+    {"1k1r3q/1ppn3p/p4b2/4p3/8/P2N2P1/1PP1R1BP/2K1Q3 w - - 0 1", "d3e5", -220},         // N for P, x-rays both ways
+    {"4k3/8/8/3q4/8/8/3R4/4K3 w - - 0 1", "d2d5", 900},                                 // hanging queen
+    {"4k3/8/2p5/3p4/8/8/3Q4/4K3 w - - 0 1", "d2d5", -800},                              // Q for a defended P
+    {"4k3/8/8/3pP3/8/8/8/4K3 w - d6 0 1", "e5d6", 100},                                 // en passant
+    {"3rk3/8/8/3p4/8/8/3R4/3RK3 w - - 0 1", "d2d5", 100},                               // doubled rooks
+    {"4k3/1P6/8/8/8/8/8/4K3 w - - 0 1", "b7b8q", 800},                                  // free promotion
+    {"r3k3/1P6/8/8/8/8/8/4K3 w - - 0 1", "b7a8q", 1300},                                // capture-promotion
+    {"r3k3/1P6/8/8/8/8/8/4K3 w - - 0 1", "b7b8q", -100},                                // promoted queen lost
+    {"4k3/4r3/8/8/8/2N5/4n3/4K3 w - - 0 1", "c3e2", 320},                               // king recaptures last
+    {"4r1k1/4r3/8/8/8/2N5/4n3/4K3 w - - 0 1", "c3e2", 0},                               // king can't recapture
+    {"4k3/8/8/8/3p4/8/8/1N2K3 w - - 0 1", "b1c3", -320},                                // quiet move en prise
+    {"4k3/8/4p3/3n4/4P3/8/8/4K3 w - - 0 1", "e4d5", 220},                               // P takes defended N
+    {"4k3/8/2b5/3p4/8/1Q6/B7/4K3 w - - 0 1", "b3d5", -470},                             // bishop behind queen
+};
+
+int see_suite(void) {
+    int failures = 0;
+    for (size_t i = 0; i < sizeof(SEE_SUITE) / sizeof(SEE_SUITE[0]); i++) {
+        const SeeCase* c = &SEE_SUITE[i];
+        const Bitboard b = init_Bitboard(c->fen);
+        MoveList list;
+        list.count = 0;
+        generate_legal_moves(&b, &list);
+
+        move16 m = MOVE_NONE;
+        char text[6];
+        for (size_t k = 0; k < list.count; k++) {
+            move_to_string(list.moves[k], text);
+            if (strcmp(text, c->move) == 0) m = list.moves[k];
+        }
+        const int value = m ? see(&b, m) : 0;
+        const bool ok = m && value == c->expected;
+        printf("%-58s %-6s %6d %s\n", c->fen, c->move, value, ok ? "ok" : "FAIL");
+        if (!ok) {
+            printf("    expected %d%s\n", c->expected, m ? "" : " (move not legal)");
+            failures++;
+        }
+    }
+    printf("%d failure(s)\n", failures);
+    return failures;
+}
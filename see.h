@@ -0,0 +1,27 @@
+//
+// Created by lenovo on 10/18/2026.
+//
+
+#ifndef SEE_H
+#define SEE_H
+
+#include <stdbool.h>
+#include "bitboard.h"
+#include "move.h"
+
+// Material the side to move gains with `m` if both sides then keep recapturing on
+// its target square with their least valuable piece while it pays, in centipawns
+// (PIECE_VALUES, king = SEE_KING_VALUE). Sliders hidden behind a capturer join in
+// as it leaves (x-rays). Recaptures on the promotion rank don't promote.
+#define SEE_KING_VALUE 20000
+int see(const Bitboard* b, move16 m);
+
+// see(b, m) >= threshold.
+static inline bool see_ge(const Bitboard* b, const move16 m, const int threshold) {
+    return see(b, m) >= threshold;
+}
+
+// Known-value positions; prints each result and returns the number of failures.
+int see_suite(void);
+
+#endif //SEE_H
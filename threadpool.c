@@ -0,0 +1,89 @@
+//
+// Created by lenovo on 10/18/2026.
+//
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <unistd.h>
+#include "threadpool.h"
+
+// One slice of task indices. Owner and thieves claim from the same counter, so
+// a claim is a single fetch_add and nobody ever takes a lock.
+typedef struct {
+    _Alignas(64) atomic_size_t next;
+    size_t end;
+} TaskSlice;
+
+typedef struct {
+    TaskSlice* slices;
+    int workers;
+    ThreadTask task;
+    void* context;
+} Pool;
+
+typedef struct {
+    Pool* pool;
+    int id;
+} Worker;
+
+static inline int claim(TaskSlice* slice, size_t* index) {
+    if (atomic_load_explicit(&slice->next, memory_order_relaxed) >= slice->end) return 0;
+    *index = atomic_fetch_add_explicit(&slice->next, 1, memory_order_relaxed);
+    return *index < slice->end;
+}
+
+static void* worker_main(void* arg) {
+    const Worker* w = arg;
+    Pool* pool = w->pool;
+    size_t index;
+
+    while (claim(&pool->slices[w->id], &index)) pool->task(pool->context, index, w->id);
+
+    // Own slice drained: steal from the others, starting with the next worker.
+    for (int k = 1; k < pool->workers; k++) {
+        TaskSlice* victim = &pool->slices[(w->id + k) % pool->workers];
+        while (claim(victim, &index)) pool->task(pool->context, index, w->id);
+    }
+    return NULL;
+}
+
+void threadpool_run(int workers, const size_t tasks, const ThreadTask task, void* context) {
+    if (workers < 1) workers = 1;
+    if (workers > THREADPOOL_MAX_WORKERS) workers = THREADPOOL_MAX_WORKERS;
+    if ((size_t)workers > tasks) workers = tasks ? (int)tasks : 1;
+
+    TaskSlice* slices = aligned_alloc(64, sizeof(TaskSlice) * (size_t)workers);
+    pthread_t threads[THREADPOOL_MAX_WORKERS];
+    Worker ids[THREADPOOL_MAX_WORKERS];
+    if (!slices) {
+        perror("threadpool");
+        exit(EXIT_FAILURE);
+    }
+
+    Pool pool = {slices, workers, task, context};
+    for (int i = 0; i < workers; i++) {
+        atomic_init(&slices[i].next, tasks * (size_t)i / (size_t)workers);
+        slices[i].end = tasks * (size_t)(i + 1) / (size_t)workers;
+        ids[i].pool = &pool;
+        ids[i].id = i;
+    }
+
+    // The calling thread works as worker 0.
+    for (int i = 1; i < workers; i++) {
+        if (pthread_create(&threads[i], NULL, worker_main, &ids[i]) != 0) {
+            perror("pthread_create");
+            exit(EXIT_FAILURE);
+        }
+    }
+    worker_main(&ids[0]);
+    for (int i = 1; i < workers; i++) pthread_join(threads[i], NULL);
+
+    free(slices);
+}
+
+int threadpool_cpu_count(void) {
+    const long n = sysconf(_SC_NPROCESSORS_ONLN);
+    return n > 0 ? (int)n : 1;
+}
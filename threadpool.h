@@ -0,0 +1,24 @@
+//
+// Created by lenovo on 10/18/2026.
+//
+
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <stddef.h>
+
+// Runs `task(context, index, worker)` for every index in [0, tasks) on `workers`
+// threads and returns when all are done. Each worker starts on its own contiguous
+// slice of the indices and, once that is drained, steals from the other slices,
+// so uneven task sizes (perft subtrees, search depths) still balance out.
+// `workers` is clamped to [1, THREADPOOL_MAX_WORKERS].
+#define THREADPOOL_MAX_WORKERS 256
+
+typedef void (*ThreadTask)(void* context, size_t index, int worker);
+
+void threadpool_run(int workers, size_t tasks, ThreadTask task, void* context);
+
+// Number of online CPUs, at least 1.
+int threadpool_cpu_count(void);
+
+#endif //THREADPOOL_H
@@ -0,0 +1,69 @@
+//
+// Created by lenovo on 10/18/2026.
+//
+#include <stdint.h>
+#include <stdbool.h>
+#include "move.h"
+#include "timeman.h"
+
+#define MOVESTOGO_DEFAULT   40      // moves assumed left in sudden death
+#define MOVESTOGO_MAX       50
+#define OPTIMUM_MAX_PCT     40      // never plan to spend more than this much of the clock on one move
+#define HARD_RATIO          5       // hard deadline: this many times the optimum...
+#define HARD_MAX_PCT        75      // ...but at most this much of the clock
+#define STABILITY_MAX       6
+#define SCORE_DROP_MAX      100     // centipawns; a larger drop counts as this
+
+void time_init(TimeManager* tm, const uint64_t movetime_ms, const uint64_t time_ms, const uint64_t inc_ms,
+               const int movestogo, const int move_overhead_ms, const int root_moves) {
+    *tm = (TimeManager){0};
+    tm->best_move = MOVE_NONE;
+    if (!movetime_ms && !time_ms) return;
+    tm->active = true;
+
+    uint64_t optimum = UINT64_MAX, hard = UINT64_MAX;
+    if (time_ms) {
+        const uint64_t overhead = (uint64_t)move_overhead_ms;
+        const uint64_t usable = time_ms > overhead ? time_ms - overhead : 1;
+        const uint64_t moves = movestogo > 0 ? (movestogo < MOVESTOGO_MAX ? (uint64_t)movestogo : MOVESTOGO_MAX)
+                                             : MOVESTOGO_DEFAULT;
+        optimum = usable / moves + inc_ms * 3 / 4;
+        if (optimum > usable * OPTIMUM_MAX_PCT / 100) optimum = usable * OPTIMUM_MAX_PCT / 100;
+        hard = optimum * HARD_RATIO;
+        if (hard > usable * HARD_MAX_PCT / 100) hard = usable * HARD_MAX_PCT / 100;
+        if (optimum == 0) optimum = 1;
+        if (hard < optimum) hard = optimum;
+        // A forced move still gets one iteration, for the ponder move and the score.
+        if (root_moves == 1) optimum = 0;
+        tm->scaled = true;
+    }
+    if (movetime_ms && movetime_ms < hard) optimum = hard = movetime_ms;
+
+    tm->optimum_ns = optimum * 1000000ULL;
+    tm->soft_ns = tm->optimum_ns;
+    tm->hard_ns = hard * 1000000ULL;
+}
+
+bool time_iteration_done(TimeManager* tm, const move16 best_move, const int score, const uint64_t elapsed_ns) {
+    if (!tm->active) return false;
+
+    if (tm->scaled) {
+        tm->stability = tm->iterations > 0 && best_move == tm->best_move
+                      ? (tm->stability < STABILITY_MAX ? tm->stability + 1 : STABILITY_MAX) : 0;
+
+        // In percent of the optimum: 150 after a new best move down to 90 once it
+        // has held for STABILITY_MAX iterations, times up to 2 for a score drop.
+        const int stability_pct = 150 - 10 * tm->stability;
+        int drop = tm->iterations > 0 ? tm->score - score : 0;
+        if (drop < 0) drop = 0;
+        if (drop > SCORE_DROP_MAX) drop = SCORE_DROP_MAX;
+        const uint64_t scale = (uint64_t)stability_pct * (uint64_t)(100 + drop);
+
+        tm->soft_ns = tm->optimum_ns / 10000 * scale;
+        if (tm->soft_ns > tm->hard_ns) tm->soft_ns = tm->hard_ns;
+    }
+    tm->best_move = best_move;
+    tm->score = score;
+    tm->iterations++;
+    return elapsed_ns >= tm->soft_ns;
+}
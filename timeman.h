@@ -0,0 +1,44 @@
+//
+// Created by lenovo on 10/18/2026.
+//
+
+#ifndef TIMEMAN_H
+#define TIMEMAN_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "move.h"
+
+// Deadlines of one search, measured from its start:
+//   soft: no new iteration once it has passed. Starts at `optimum` and is rescaled
+//         after every iteration: shorter while the best move stays the same, longer
+//         after it changes or the score drops.
+//   hard: the search is aborted mid-iteration. Only ever read every few thousand
+//         nodes, so the clock is not queried per node.
+// A fixed movetime sets both to the same value and is never rescaled.
+typedef struct {
+    bool active;            // false: no time limit at all
+    bool scaled;            // the soft deadline follows the search (clock play)
+    uint64_t optimum_ns;
+    uint64_t soft_ns;
+    uint64_t hard_ns;
+
+    move16 best_move;       // of the last completed iteration
+    int stability;          // iterations in a row it has stayed the best move
+    int score;
+    int iterations;
+} TimeManager;
+
+// `time_ms` is the side to move's clock (0 = untimed), `root_moves` the number of
+// legal moves: with a single one there is nothing to think about.
+void time_init(TimeManager* tm, uint64_t movetime_ms, uint64_t time_ms, uint64_t inc_ms, int movestogo,
+               int move_overhead_ms, int root_moves);
+
+// After every completed iteration. True if the next one should not be started.
+bool time_iteration_done(TimeManager* tm, move16 best_move, int score, uint64_t elapsed_ns);
+
+static inline bool time_hard_expired(const TimeManager* tm, const uint64_t elapsed_ns) {
+    return tm->active && elapsed_ns >= tm->hard_ns;
+}
+
+#endif //TIMEMAN_H
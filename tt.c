@@ -0,0 +1,129 @@
+//
+// Created by lenovo on 10/18/2026.
+//
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "tt.h"
+
+#define TT_GENERATION_MASK 0x3F
+
+TranspositionTable TT = {NULL, 0, 0};
+
+static inline uint64_t pack(move16 move, int score, int eval, int depth, int bound, uint8_t generation) {
+    return (uint64_t)move
+         | (uint64_t)(uint16_t)(int16_t)score << 16
+         | (uint64_t)(uint16_t)(int16_t)eval << 32
+         | (uint64_t)(uint8_t)(int8_t)depth << 48
+         | (uint64_t)(bound & 3) << 56
+         | (uint64_t)(generation & TT_GENERATION_MASK) << 58;
+}
+
+static inline void unpack(uint64_t data, TTData* out) {
+    out->move = (move16)data;
+    out->score = (int16_t)(uint16_t)(data >> 16);
+    out->eval = (int16_t)(uint16_t)(data >> 32);
+    out->depth = (int8_t)(uint8_t)(data >> 48);
+    out->bound = (uint8_t)((data >> 56) & 3);
+}
+
+static inline uint8_t entry_generation(uint64_t data) {
+    return (uint8_t)(data >> 58);
+}
+
+static inline int entry_depth(uint64_t data) {
+    return (int8_t)(uint8_t)(data >> 48);
+}
+
+void tt_resize(const size_t mb) {
+    tt_free();
+    size_t count = (mb * 1024 * 1024) / sizeof(TTBucket);
+    if (count == 0) count = 1;
+
+    TT.buckets = aligned_alloc(64, count * sizeof(TTBucket));
+    if (!TT.buckets) {
+        fprintf(stderr, "Failed to allocate %zu MB transposition table\n", mb);
+        exit(EXIT_FAILURE);
+    }
+    TT.bucket_count = count;
+    tt_clear();
+}
+
+void tt_clear(void) {
+    memset(TT.buckets, 0, TT.bucket_count * sizeof(TTBucket));
+    TT.generation = 0;
+}
+
+void tt_free(void) {
+    free(TT.buckets);
+    TT.buckets = NULL;
+    TT.bucket_count = 0;
+}
+
+void tt_new_search(void) {
+    TT.generation = (TT.generation + 1) & TT_GENERATION_MASK;
+}
+
+bool tt_probe(const uint64_t key, TTData* out) {
+    TTBucket* bucket = tt_bucket(key);
+    for (int i = 0; i < TT_BUCKET_ENTRIES; i++) {
+        TTEntry* e = &bucket->entries[i];
+        const uint64_t data = atomic_load_explicit(&e->data, memory_order_relaxed);
+        const uint64_t check = atomic_load_explicit(&e->check, memory_order_relaxed);
+        if ((check ^ data) == key && data) {
+            unpack(data, out);
+            return true;
+        }
+    }
+    return false;
+}
+
+void tt_store(const uint64_t key, move16 move, const int score, const int eval, const int depth, const int bound) {
+    TTBucket* bucket = tt_bucket(key);
+    TTEntry* replace = NULL;
+    int worst = 1 << 30;
+
+    for (int i = 0; i < TT_BUCKET_ENTRIES; i++) {
+        TTEntry* e = &bucket->entries[i];
+        const uint64_t data = atomic_load_explicit(&e->data, memory_order_relaxed);
+        const uint64_t check = atomic_load_explicit(&e->check, memory_order_relaxed);
+
+        if ((check ^ data) == key) {
+            // Same position: keep the old move if the new search did not find one, and
+            // don't let a shallow non-exact result overwrite a deeper one.
+            if (move == MOVE_NONE) move = (move16)data;
+            if (bound != BOUND_EXACT && depth + 2 < entry_depth(data) &&
+                entry_generation(data) == TT.generation) {
+                return;
+            }
+            replace = e;
+            break;
+        }
+
+        // Otherwise evict the shallowest entry, counting each generation of age as 8 plies.
+        const int age = (TT.generation - entry_generation(data)) & TT_GENERATION_MASK;
+        const int value = data ? entry_depth(data) - 8 * age : -(1 << 20);
+        if (value < worst) {
+            worst = value;
+            replace = e;
+        }
+    }
+
+    const uint64_t data = pack(move, score, eval, depth, bound, TT.generation);
+    atomic_store_explicit(&replace->data, data, memory_order_relaxed);
+    atomic_store_explicit(&replace->check, key ^ data, memory_order_relaxed);
+}
+
+int tt_hashfull(void) {
+    int used = 0;
+    const size_t samples = TT.bucket_count < 1000 ? TT.bucket_count : 1000;
+    for (size_t i = 0; i < samples; i++) {
+        for (int j = 0; j < TT_BUCKET_ENTRIES; j++) {
+            const uint64_t data = atomic_load_explicit(&TT.buckets[i].entries[j].data, memory_order_relaxed);
+            used += data && entry_generation(data) == TT.generation;
+        }
+    }
+    return samples ? (int)(used * 1000 / (samples * TT_BUCKET_ENTRIES)) : 0;
+}
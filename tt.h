@@ -0,0 +1,75 @@
+//
+// Created by lenovo on 10/18/2026.
+//
+
+#ifndef TT_H
+#define TT_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+#include "move.h"
+
+#define BOUND_NONE   0
+#define BOUND_UPPER  1
+#define BOUND_LOWER  2
+#define BOUND_EXACT  3
+
+// 16-byte entry. `check` stores key ^ data: a slot half-written by another thread
+// fails verification and reads as a miss, so no locks are needed.
+// data: move (16) | score (16) | static eval (16) | depth (8) | bound (2) | generation (6)
+typedef struct {
+    _Atomic uint64_t check;
+    _Atomic uint64_t data;
+} TTEntry;
+
+#define TT_BUCKET_ENTRIES 4
+
+// One 64-byte cache line.
+typedef struct {
+    _Alignas(64) TTEntry entries[TT_BUCKET_ENTRIES];
+} TTBucket;
+
+typedef struct {
+    TTBucket* buckets;
+    size_t bucket_count;
+    uint8_t generation;
+} TranspositionTable;
+
+typedef struct {
+    move16 move;
+    int16_t score;
+    int16_t eval;
+    int8_t depth;
+    uint8_t bound;
+} TTData;
+
+extern TranspositionTable TT;
+
+// (Re)allocates the table with `mb` megabytes and clears it. Not thread-safe:
+// call while no search is running.
+void tt_resize(size_t mb);
+void tt_clear(void);
+void tt_free(void);
+
+// Advances the generation so entries from earlier searches age out.
+void tt_new_search(void);
+
+bool tt_probe(uint64_t key, TTData* out);
+void tt_store(uint64_t key, move16 move, int score, int eval, int depth, int bound);
+
+// Table occupancy by entries of the current generation, in permille (UCI hashfull).
+int tt_hashfull(void);
+
+static inline TTBucket* tt_bucket(uint64_t key) {
+    return &TT.buckets[(size_t)(((unsigned __int128)key * TT.bucket_count) >> 64)];
+}
+
+// Call right after making a move: the bucket load then overlaps move generation
+// for the child instead of stalling the probe.
+static inline void tt_prefetch(uint64_t key) {
+    __builtin_prefetch(tt_bucket(key));
+}
+
+#endif //TT_H
@@ -0,0 +1,309 @@
+//
+// Created by lenovo on 10/18/2026.
+//
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <strings.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include "constants.h"
+#include "bitboard.h"
+#include "move.h"
+#include "movegeneration.h"
+#include "search.h"
+#include "tt.h"
+#include "mcts.h"
+#include "uci.h"
+
+#define UCI_START_FEN     "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1"
+#define UCI_HASH_DEFAULT  16
+#define UCI_HASH_MAX      65536
+#define UCI_EVAL_CACHE_DEFAULT  EVAL_CACHE_DEFAULT_KB
+#define UCI_EVAL_CACHE_MAX      (1 << 20)
+
+// --- Game state (input thread only) ---
+
+// The position after "position ...", and the keys of the positions before it back
+// to the last irreversible move: nothing older can repeat.
+static Bitboard game;
+static uint64_t game_keys[MAX_GAME_PLY];
+static int game_key_count;
+
+static size_t hash_mb = UCI_HASH_DEFAULT;
+static int threads = 1;
+static bool use_mcts;               // search with Monte Carlo tree search instead of alpha-beta
+
+// --- Search thread ---
+
+// Written by the input thread before the search thread starts, read-only while it runs.
+static Bitboard search_root;
+static uint64_t search_keys[MAX_GAME_PLY];
+static int search_key_count;
+static SearchLimits search_limits;
+static bool search_infinite;        // "go infinite" / "go ponder": no bestmove before stop or ponderhit
+
+static pthread_t search_thread;
+static bool searching;              // input thread: search_thread has not been joined yet
+
+// An infinite or ponder search that ends on its own waits here until it may report.
+static pthread_mutex_t report_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t report_cond = PTHREAD_COND_INITIALIZER;
+static bool report_released;
+
+static void* search_main(void* arg) {
+    (void)arg;
+    SearchResult result;
+    if (use_mcts) mcts_search(&search_root, search_keys, search_key_count, &search_limits, &result);
+    else search_position(&search_root, search_keys, search_key_count, &search_limits, &result);
+
+    pthread_mutex_lock(&report_lock);
+    while (!report_released && (search_infinite || atomic_load(&SEARCH_PONDER))) {
+        pthread_cond_wait(&report_cond, &report_lock);
+    }
+    pthread_mutex_unlock(&report_lock);
+
+    char best[6], ponder[6];
+    move_to_string(result.best_move, best);
+    if (result.pv_length > 1 && result.pv[0] == result.best_move) {
+        move_to_string(result.pv[1], ponder);
+        printf("bestmove %s ponder %s\n", best, ponder);
+    } else {
+        printf("bestmove %s\n", result.best_move ? best : "0000");
+    }
+    fflush(stdout);
+    return NULL;
+}
+
+static void release_report(const bool stop) {
+    pthread_mutex_lock(&report_lock);
+    if (stop) report_released = true;
+    pthread_cond_broadcast(&report_cond);
+    pthread_mutex_unlock(&report_lock);
+}
+
+static void stop_search(void) {
+    if (!searching) return;
+    atomic_store(&SEARCH_STOP, true);
+    atomic_store(&SEARCH_PONDER, false);
+    release_report(true);
+}
+
+// Waits for the search thread to finish; call before touching anything it reads.
+static void join_search(void) {
+    if (!searching) return;
+    pthread_join(search_thread, NULL);
+    searching = false;
+}
+
+static void start_search(const SearchLimits* limits, const bool infinite, const bool ponder) {
+    stop_search();
+    join_search();
+    search_root = game;
+    search_root.nnue = NULL;
+    memcpy(search_keys, game_keys, (size_t)game_key_count * sizeof(uint64_t));
+    search_key_count = game_key_count;
+    search_limits = *limits;
+    search_infinite = infinite;
+    report_released = false;
+    // A stop sent just as the previous search ended may still be set.
+    atomic_store(&SEARCH_STOP, false);
+    atomic_store(&SEARCH_PONDER, ponder);
+
+    if (pthread_create(&search_thread, NULL, search_main, NULL) != 0) {
+        perror("pthread_create");
+        exit(EXIT_FAILURE);
+    }
+    searching = true;
+}
+
+// --- Commands ---
+
+static move16 parse_move(const Bitboard* b, const char* text) {
+    MoveList list;
+    list.count = 0;
+    generate_legal_moves(b, &list);
+    char move[6];
+    for (size_t i = 0; i < list.count; i++) {
+        move_to_string(list.moves[i], move);
+        if (strcmp(move, text) == 0) return list.moves[i];
+    }
+    return MOVE_NONE;
+}
+
+// position [startpos | fen <fen>] [moves <move>...]
+// Moves are made in place on one board; its undo records are never needed. A FEN that
+// is malformed or not a legal position leaves the previous position in place.
+static void uci_position(char* args) {
+    char* moves = strstr(args, "moves");
+    if (moves) *moves = '\0';
+
+    char* fen = strstr(args, "fen");
+    Bitboard parsed;
+    if (!try_init_Bitboard(fen ? fen + 3 + strspn(fen + 3, " ") : UCI_START_FEN, &parsed) ||
+        !position_is_legal(&parsed)) {
+        printf("info string invalid position\n");
+        fflush(stdout);
+        return;
+    }
+    game = parsed;
+    game_key_count = 0;
+    if (!moves) return;
+
+    char* save = NULL;
+    for (char* token = strtok_r(moves + 5, " \t\r\n", &save); token; token = strtok_r(NULL, " \t\r\n", &save)) {
+        const move16 m = parse_move(&game, token);
+        if (m == MOVE_NONE) {
+            printf("info string illegal move %s, ignoring the rest\n", token);
+            fflush(stdout);
+            return;
+        }
+        if (game_key_count == MAX_GAME_PLY) {
+            memmove(game_keys, game_keys + 1, (MAX_GAME_PLY - 1) * sizeof(uint64_t));
+            game_key_count--;
+        }
+        game_keys[game_key_count++] = game.key;
+        Undo undo;
+        make_move(&game, m, &undo);
+        if (game.halfmove_clock == 0) game_key_count = 0;
+    }
+}
+
+// go [depth N] [nodes N] [movetime MS] [wtime MS] [btime MS] [winc MS] [binc MS]
+//    [movestogo N] [infinite] [ponder]
+static void uci_go(char* args) {
+    SearchLimits limits = {.threads = threads};
+    uint64_t time_ms[2] = {0, 0}, inc_ms[2] = {0, 0};
+    bool infinite = false, ponder = false;
+
+    char* save = NULL;
+    for (char* token = strtok_r(args, " \t\r\n", &save); token; token = strtok_r(NULL, " \t\r\n", &save)) {
+        if (strcmp(token, "infinite") == 0) { infinite = true; continue; }
+        if (strcmp(token, "ponder") == 0) { ponder = true; continue; }
+
+        const char* value = strtok_r(NULL, " \t\r\n", &save);
+        if (!value) break;
+        const uint64_t n = strtoull(value, NULL, 10);
+        if (strcmp(token, "depth") == 0) limits.depth = (int)n;
+        else if (strcmp(token, "nodes") == 0) limits.nodes = n;
+        else if (strcmp(token, "movetime") == 0) limits.movetime_ms = n;
+        else if (strcmp(token, "wtime") == 0) time_ms[WHITE] = n;
+        else if (strcmp(token, "btime") == 0) time_ms[BLACK] = n;
+        else if (strcmp(token, "winc") == 0) inc_ms[WHITE] = n;
+        else if (strcmp(token, "binc") == 0) inc_ms[BLACK] = n;
+        else if (strcmp(token, "movestogo") == 0) limits.movestogo = (int)n;
+    }
+    limits.time_ms = time_ms[game.to_move];
+    limits.inc_ms = inc_ms[game.to_move];
+
+    start_search(&limits, infinite, ponder);
+}
+
+static void print_options(void) {
+    printf("option name Hash type spin default %d min 1 max %d\n", UCI_HASH_DEFAULT, UCI_HASH_MAX);
+    printf("option name Threads type spin default 1 min 1 max %d\n", MAX_SEARCH_THREADS);
+    printf("option name EvalCache type spin default %d min 0 max %d\n", UCI_EVAL_CACHE_DEFAULT, UCI_EVAL_CACHE_MAX);
+    printf("option name Ponder type check default false\n");
+    printf("option name Clear Hash type button\n");
+    printf("option name UseMCTS type check default false\n");
+    printf("option name MCTSHash type spin default %d min 1 max %d\n", MCTS_DEFAULT_MB, UCI_HASH_MAX);
+    for (int i = 0; i < SEARCH_PARAM_COUNT; i++) {
+        const SearchParam* p = &SEARCH_PARAMS[i];
+        printf("option name %s type spin default %d min %d max %d\n", p->name, p->default_value, p->min, p->max);
+    }
+}
+
+// setoption name <name> [value <value>]. Names are case-insensitive and may contain spaces.
+static void uci_setoption(char* args) {
+    char* name = strstr(args, "name");
+    if (!name) return;
+    name += 4 + strspn(name + 4, " ");
+    char* value = strstr(name, " value");
+    if (value) {
+        *value = '\0';
+        value += 6 + strspn(value + 6, " ");
+    }
+    size_t length = strlen(name);
+    while (length && name[length - 1] == ' ') name[--length] = '\0';
+    const long n = value ? strtol(value, NULL, 10) : 0;
+
+    // Options are only meant to change between searches; don't resize under one.
+    stop_search();
+    join_search();
+    if (strcasecmp(name, "Hash") == 0 && n >= 1 && n <= UCI_HASH_MAX) {
+        hash_mb = (size_t)n;
+        tt_resize(hash_mb);
+    } else if (strcasecmp(name, "Threads") == 0 && n >= 1 && n <= MAX_SEARCH_THREADS) {
+        threads = (int)n;
+    } else if (strcasecmp(name, "EvalCache") == 0 && n >= 0 && n <= UCI_EVAL_CACHE_MAX) {
+        search_set_eval_cache((size_t)n);
+    } else if (strcasecmp(name, "Ponder") == 0) {
+        // The GUI only tells us whether it will send "go ponder"; nothing to configure.
+    } else if (strcasecmp(name, "Clear Hash") == 0) {
+        tt_clear();
+        mcts_clear();
+    } else if (strcasecmp(name, "UseMCTS") == 0 && value) {
+        use_mcts = strcasecmp(value, "true") == 0;
+    } else if (strcasecmp(name, "MCTSHash") == 0 && n >= 1 && n <= UCI_HASH_MAX) {
+        mcts_set_memory((size_t)n);
+    } else if (!value || !search_set_param(name, (int)n)) {
+        printf("info string unknown option or value out of range: %s\n", name);
+        fflush(stdout);
+    }
+}
+
+void uci_loop(void) {
+    game = init_Bitboard(UCI_START_FEN);
+    game_key_count = 0;
+    tt_resize(hash_mb);
+
+    char* line = NULL;
+    size_t capacity = 0;
+    while (getline(&line, &capacity, stdin) != -1) {
+        line[strcspn(line, "\r\n")] = '\0';
+        char* args = line + strspn(line, " \t");
+        const size_t length = strcspn(args, " \t");
+        char* rest = args + length + strspn(args + length, " \t");
+        if (length == 0) continue;
+        if (args[length]) args[length] = '\0';
+        const char* command = args;
+
+        if (strcmp(command, "uci") == 0) {
+            printf("id name ChessEngine\n");
+            printf("id author the ChessEngine developers\n");
+            print_options();
+            printf("uciok\n");
+        } else if (strcmp(command, "isready") == 0) {
+            printf("readyok\n");
+        } else if (strcmp(command, "ucinewgame") == 0) {
+            stop_search();
+            join_search();
+            tt_clear();
+            mcts_clear();
+        } else if (strcmp(command, "position") == 0) {
+            uci_position(rest);
+        } else if (strcmp(command, "go") == 0) {
+            uci_go(rest);
+        } else if (strcmp(command, "stop") == 0) {
+            stop_search();
+        } else if (strcmp(command, "ponderhit") == 0) {
+            atomic_store(&SEARCH_PONDER, false);
+            release_report(false);
+        } else if (strcmp(command, "setoption") == 0) {
+            uci_setoption(rest);
+        } else if (strcmp(command, "d") == 0) {
+            print_board(game);
+        } else if (strcmp(command, "quit") == 0) {
+            break;
+        } else {
+            printf("info string unknown command %s\n", command);
+        }
+        fflush(stdout);
+    }
+
+    stop_search();
+    join_search();
+    free(line);
+}
@@ -0,0 +1,13 @@
+//
+// Created by lenovo on 10/18/2026.
+//
+
+#ifndef UCI_H
+#define UCI_H
+
+// Reads UCI commands from stdin until "quit" or end of input. Searches run on a
+// thread of their own, so "stop", "ponderhit" and "isready" are answered while
+// one is in progress.
+void uci_loop(void);
+
+#endif //UCI_H
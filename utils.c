@@ -6,6 +6,7 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include <ctype.h>
+#include <time.h>
 #include "constants.h"
 #include "utils.h"
 
@@ -19,4 +20,9 @@ uint8_t rank_from_bit(uint64_t sq) {
 }
 uint8_t file_from_bit(uint64_t sq) {
     return sq >> 3;
-}
\ No newline at end of file
+}
+uint64_t time_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
@@ -9,4 +9,33 @@
 
 uint64_t square_bit(int row, int col);
 
+// Monotonic wall clock in nanoseconds, for timing perft and search.
+uint64_t time_now_ns(void);
+
+// Index of the least significant set bit. `x` must be non-zero.
+static inline int lsb(uint64_t x) {
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward64(&index, x);
+    return (int)index;
+#else
+    return __builtin_ctzll(x);
+#endif
+}
+
+// Clears the least significant set bit of `*x` and returns its index.
+static inline int pop_lsb(uint64_t* x) {
+    const int sq = lsb(*x);
+    *x &= *x - 1;
+    return sq;
+}
+
+static inline int popcount(uint64_t x) {
+#if defined(_MSC_VER)
+    return (int)__popcnt64(x);
+#else
+    return __builtin_popcountll(x);
+#endif
+}
+
 #endif //UTILS_H
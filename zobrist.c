@@ -0,0 +1,80 @@
+//
+// Created by lenovo on 10/18/2026.
+//
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include "constants.h"
+#include "bitboard.h"
+#include "zobrist.h"
+#include "utils.h"
+
+uint64_t ZOBRIST_PIECES[12][64];
+uint64_t ZOBRIST_CASTLING[16];
+uint64_t ZOBRIST_EN_PASSANT[8];
+uint64_t ZOBRIST_SIDE;
+uint64_t ZOBRIST_MATERIAL[12][ZOBRIST_MAX_COUNT];
+
+// xorshift64*
+static uint64_t next_random(uint64_t* state) {
+    *state ^= *state >> 12;
+    *state ^= *state << 25;
+    *state ^= *state >> 27;
+    return *state * 0x2545F4914F6CDD1DULL;
+}
+
+void init_zobrist(void) {
+    uint64_t state = 0x6A09E667F3BCC909ULL;
+
+    for (int i = 0; i < 12; i++) {
+        for (int sq = 0; sq < 64; sq++) ZOBRIST_PIECES[i][sq] = next_random(&state);
+    }
+    for (int i = 0; i < 16; i++) ZOBRIST_CASTLING[i] = next_random(&state);
+    for (int f = 0; f < 8; f++) ZOBRIST_EN_PASSANT[f] = next_random(&state);
+    ZOBRIST_SIDE = next_random(&state);
+    for (int i = 0; i < 12; i++) {
+        for (int n = 0; n < ZOBRIST_MAX_COUNT; n++) ZOBRIST_MATERIAL[i][n] = next_random(&state);
+    }
+}
+
+uint64_t compute_key(const Bitboard* b) {
+    uint64_t key = 0;
+    for (int i = 0; i < 12; i++) {
+        uint64_t pieces = b->pieces[i];
+        while (pieces) key ^= ZOBRIST_PIECES[i][pop_lsb(&pieces)];
+    }
+    key ^= ZOBRIST_CASTLING[b->castling_rights & 0xF];
+    if (b->en_passant_target) key ^= ZOBRIST_EN_PASSANT[b->en_passant_file];
+    if (b->to_move == BLACK) key ^= ZOBRIST_SIDE;
+    return key;
+}
+
+uint64_t compute_pawn_key(const Bitboard* b) {
+    uint64_t key = 0;
+    for (int i = INDEX_WPAWN; i <= INDEX_BPAWN; i += INDEX_BPAWN - INDEX_WPAWN) {
+        uint64_t pawns = b->pieces[i];
+        while (pawns) key ^= ZOBRIST_PIECES[i][pop_lsb(&pawns)];
+    }
+    return key;
+}
+
+// XOR of ZOBRIST_MATERIAL[i][0 .. count-1] for every piece index, so adding or
+// removing one piece is a single XOR of the entry at the smaller count.
+uint64_t compute_material_key(const Bitboard* b) {
+    uint64_t key = 0;
+    for (int i = 0; i < 12; i++) {
+        const int count = popcount(b->pieces[i]);
+        for (int n = 0; n < count && n < ZOBRIST_MAX_COUNT; n++) key ^= ZOBRIST_MATERIAL[i][n];
+    }
+    return key;
+}
+
+void verify_keys(const Bitboard* b, const char* where) {
+    if (b->key == compute_key(b) && b->pawn_key == compute_pawn_key(b) &&
+        b->material_key == compute_material_key(b)) {
+        return;
+    }
+    fprintf(stderr, "Zobrist key mismatch after %s\n", where);
+    print_board(*b);
+    abort();
+}
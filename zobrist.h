@@ -0,0 +1,32 @@
+//
+// Created by lenovo on 10/18/2026.
+//
+
+#ifndef ZOBRIST_H
+#define ZOBRIST_H
+
+#include <stdint.h>
+#include "bitboard.h"
+
+#define ZOBRIST_MAX_COUNT 16   // per-piece counts covered by the material key
+
+extern uint64_t ZOBRIST_PIECES[12][64];
+extern uint64_t ZOBRIST_CASTLING[16];
+extern uint64_t ZOBRIST_EN_PASSANT[8];          // by file
+extern uint64_t ZOBRIST_SIDE;                   // black to move
+extern uint64_t ZOBRIST_MATERIAL[12][ZOBRIST_MAX_COUNT];
+
+// Fills the key tables from a fixed seed, so keys are stable across runs.
+// Call once at startup, before the first init_Bitboard.
+void init_zobrist(void);
+
+// From-scratch computations. make_move/unmake_move keep the Bitboard fields
+// up to date incrementally; these are for initialisation and cross-checks.
+uint64_t compute_key(const Bitboard* b);
+uint64_t compute_pawn_key(const Bitboard* b);
+uint64_t compute_material_key(const Bitboard* b);
+
+// Aborts with a diagnostic if any incremental key differs from a recompute.
+void verify_keys(const Bitboard* b, const char* where);
+
+#endif //ZOBRIST_H